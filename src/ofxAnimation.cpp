@@ -1,5 +1,8 @@
 #include "ofxAnimation.h"
 #include "ofUtils.h"
+#include "ofxClock.h"
+#include <algorithm>
+#include <map>
 
 //class ofxTween 
 ofxTween::ofxTween(ofxObject *iObject, ofxMessage *iMessage)
@@ -16,7 +19,7 @@ ofxTween::~ofxTween()
 
 void ofxTween::start()
 {
-	message->setStartTime(ofGetElapsedTimef());
+	message->setStartTime(ofxClock::getCurrentTime());
 	message->enableMessage(true);
 	message->isRunning = false;
 	object->doMessage(message);		
@@ -34,7 +37,12 @@ void ofxTween::stop()
 //class ofxAnimation 
 ofxAnimation::ofxAnimation()
 {
-
+	isResolved = false;
+	playing = false;
+	hasUpdated = false;
+	playhead = 0;
+	lastUpdateTime = 0;
+	timeScale = 1.0;
 }
 
 ofxAnimation::~ofxAnimation()
@@ -55,6 +63,7 @@ void ofxAnimation::start()
 
 void ofxAnimation::stop()
 {
+	playing = false;
 	for(unsigned int i=0; i < tweens.size(); i++){
 		tweens[i]->stop();
 	}
@@ -63,16 +72,20 @@ void ofxAnimation::stop()
 //Note: This relies on the fact that ofxMessages are "enabled" until they are completed.
 bool ofxAnimation::isAnimating()
 {
-	bool animating = false;
+	if(playing)
+		return (timeScale >= 0) ? (playhead < getDuration()) : (playhead > 0);
+
+	float time = ofxClock::getCurrentTime();
 
 	//adding second part of OR to account for delay period before isRunning gets set
 	for(unsigned int i=0; i < tweens.size(); i++){
-		if(tweens[i]->message->isRunning || 
-           (ofGetElapsedTimef() >= tweens[i]->message->startTime && ofGetElapsedTimef() < tweens[i]->message->startTime + tweens[i]->message->startDelay))
-			animating = true;
+		ofxMessage *message = tweens[i]->message;
+		if(message->isRunning || 
+           (time >= message->startTime && time < message->startTime + message->startDelay))
+			return true;
 	}
 
-	return animating;
+	return false;
 }
 
 float ofxAnimation::getDuration()
@@ -81,57 +94,51 @@ float ofxAnimation::getDuration()
 	for(unsigned int i=0; i < tweens.size(); i++){
 		dur = MAX(dur, (float)(tweens[i]->message->startDelay + tweens[i]->message->duration));
 	}
+	for(unsigned int i=0; i < bakedTracks.size(); i++){
+		dur = MAX(dur, bakedTracks[i]->getDuration());
+	}
 
 	return dur;
 }
 
 ofxTween* ofxAnimation::tween(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, float iX0, float iX1, int iPlayMode)
 {
-	//make target vals
-	float *args = new float[1];
-	args[0] = iX1;
 	//make message
-	ofxMessage *message = new ofxMessage(iID, (void *)args, iInterp, iEndTime-iStartTime, iStartTime, iPlayMode);
+	ofxMessage *message = new ofxMessage(iID, ofVec4f(iX1, 0, 0, 0), iInterp, iEndTime-iStartTime, iStartTime, iPlayMode);
 	message->setBaseStartVals(iX0);
 	//message->isRelative = false;
 	message->autoDelete = false;
 
 	ofxTween *tween = new ofxTween(iObject, message);
-	tweens.push_back(tween);
+	addTween(tween);
 
 	return tween;
 }
 
 ofxTween* ofxAnimation::tween(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, float iX0, float iY0, float iZ0, float iX1, float iY1, float iZ1, int iPlayMode)
 {
-	//make target vals
-	ofVec3f *args = new ofVec3f();
-	args->set(iX1, iY1, iZ1);
 	//make message
-	ofxMessage *message = new ofxMessage(iID, (void *)args, iInterp, iEndTime-iStartTime, iStartTime, iPlayMode);
+	ofxMessage *message = new ofxMessage(iID, ofVec4f(iX1, iY1, iZ1, 0), iInterp, iEndTime-iStartTime, iStartTime, iPlayMode);
 	message->setBaseStartVals(iX0, iY0, iZ0);
 	//message->isRelative = false;
 	message->autoDelete = false;
 
 	ofxTween *tween = new ofxTween(iObject, message);
-	tweens.push_back(tween);
+	addTween(tween);
 
 	return tween;
 }
 
 ofxTween* ofxAnimation::tween(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, float iX0, float iY0, float iZ0, float iW0, float iX1, float iY1, float iZ1, float iW1, int iPlayMode)
 {
-	//make target vals
-	ofVec4f *args = new ofVec4f();
-	args->set(iX1, iY1, iZ1, iW1);
 	//make message
-	ofxMessage *message = new ofxMessage(iID, (void *)args, iInterp, iEndTime-iStartTime, iStartTime, iPlayMode);
+	ofxMessage *message = new ofxMessage(iID, ofVec4f(iX1, iY1, iZ1, iW1), iInterp, iEndTime-iStartTime, iStartTime, iPlayMode);
 	message->setBaseStartVals(iX0, iY0, iZ0, iW0);
 	//message->isRelative = false;
 	message->autoDelete = false;
 
 	ofxTween *tween = new ofxTween(iObject, message);
-	tweens.push_back(tween);
+	addTween(tween);
 
 	return tween;
 }
@@ -148,48 +155,48 @@ ofxTween* ofxAnimation::tween(ofxObject *iObject, int iID, float iStartTime, flo
 
 ofxTween* ofxAnimation::showObject(ofxObject *iObject, float iTime, int iPlayMode)
 {
-	ofxMessage *message = new ofxMessage(OF_SHOW, NULL, OF_LINEAR, 0, iTime, iPlayMode);	
+	ofxMessage *message = new ofxMessage(OF_SHOW, ofVec4f(0, 0, 0, 0), OF_LINEAR, 0, iTime, iPlayMode);	
 	message->autoDelete = false;
 
 	ofxTween *tween = new ofxTween(iObject, message);
-	tweens.push_back(tween);
+	addTween(tween);
 
 	return tween;
 }
 
 ofxTween* ofxAnimation::hideObject(ofxObject *iObject, float iTime, int iPlayMode)
 {
-	ofxMessage *message = new ofxMessage(OF_HIDE, NULL, OF_LINEAR, 0, iTime, iPlayMode);	
+	ofxMessage *message = new ofxMessage(OF_HIDE, ofVec4f(0, 0, 0, 0), OF_LINEAR, 0, iTime, iPlayMode);	
 	message->autoDelete = false;
 
 	ofxTween *tween = new ofxTween(iObject, message);
-	tweens.push_back(tween);
+	addTween(tween);
 
 	return tween;
 }
 
 //This method lets you specify bezier animation paths, through a vector of ofVec4f, which are treated as control points for the path.
-ofxTween* ofxAnimation::tweenBezier(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, vector<ofVec4f> iPath, int iPlayMode)
+ofxTween* ofxAnimation::tweenBezier(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, const vector<ofVec4f> &iPath, int iPlayMode)
 {	
 	//make message
 	ofxMessage *message = new ofxMessage(iID, iInterp, OF_BEZIER_PATH, iPath, iEndTime-iStartTime, iStartTime, iPlayMode);	
 	message->autoDelete = false;
 
 	ofxTween *tween = new ofxTween(iObject, message);
-	tweens.push_back(tween);
+	addTween(tween);
 
 	return tween;
 }
 
 //This method lets you specify spline animation paths, through a vector of ofVec4f, which are treated as control points for the path.
-ofxTween* ofxAnimation::tweenSpline(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, vector<ofVec4f> iPath, int iPlayMode)
+ofxTween* ofxAnimation::tweenSpline(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, const vector<ofVec4f> &iPath, int iPlayMode)
 {
 	//make message
 	ofxMessage *message = new ofxMessage(iID, iInterp, OF_SPLINE_PATH, iPath, iEndTime-iStartTime, iStartTime, iPlayMode);	
 	message->autoDelete = false;
 
 	ofxTween *tween = new ofxTween(iObject, message);
-	tweens.push_back(tween);
+	addTween(tween);
 
 	return tween;
 }
@@ -202,9 +209,276 @@ ofxTween* ofxAnimation::tweenFunc(ofxObject *iObject, float (*iFunction)(void *)
     message->autoDelete = false;
     
     ofxTween *tween = new ofxTween(iObject, message);
-    tweens.push_back(tween);
+    addTween(tween);
     
     return tween;
 }
 
+//Plays baked keyframe tracks along with the tweens. Only the tracks bound to objects are applied.
+void ofxAnimation::addBakedTracks(ofxBakedTracks *iTracks)
+{
+	bakedTracks.push_back(iTracks);
+}
+
+
+
+
+//Seeking ______________________________________________________________________________
+
+//Sorts the tweens into tracks and resolves relative start and end values, as if the animation played from
+//the start with every object as it is now. Called on the first seek() or play() after tweens are added,
+//or again to pick up objects' current values.
+void ofxAnimation::resolve()
+{
+	tracks.clear();
+	functionTweens.clear();
+	map<pair<ofxObject *, int>, int> trackIndices;
+
+	for(unsigned int i=0; i < tweens.size(); i++){
+		ofxTween *tween = tweens[i];
+		if(tween->message->id == OF_FUNCTION) functionTweens.push_back(tween);
+		int id = getTrackID(tween->message->id);
+		if(id < 0) continue;
+
+		pair<ofxObject *, int> key(tween->object, id);
+		map<pair<ofxObject *, int>, int>::iterator it = trackIndices.find(key);
+		int t;
+		if(it != trackIndices.end())
+			t = it->second;
+		else{
+			t = (int)tracks.size();
+			trackIndices[key] = t;
+			ofxAnimationTrack track;
+			track.object = tween->object;
+			track.id = id;
+			track.baseVals = getObjectVals(tween->object, id);
+			tracks.push_back(track);
+		}
+		tracks[t].tweens.push_back(tween);
+	}
+
+	for(unsigned int t=0; t < tracks.size(); t++){
+		ofxAnimationTrack &track = tracks[t];
+		stable_sort(track.tweens.begin(), track.tweens.end(),
+					[](ofxTween *a, ofxTween *b){ return a->message->startDelay < b->message->startDelay; });
+
+		//each tween starts from wherever the one before it left off
+		ofVec4f cur = track.baseVals;
+		track.startTimes.resize(track.tweens.size());
+		for(unsigned int i=0; i < track.tweens.size(); i++){
+			ofxTween *tween = track.tweens[i];
+			ofxMessage *message = tween->message;
+			track.startTimes[i] = message->startDelay;
+
+			for(int c=0; c < 4; c++){
+				tween->startVals[c] = (message->baseStartVals[c] == OF_RELATIVE_VAL) ? cur[c] : message->baseStartVals[c];
+				tween->endVals[c] = (message->baseEndVals[c] == OF_RELATIVE_VAL) ? cur[c] : message->baseEndVals[c];
+			}
+			if(message->path != OF_LINEAR_PATH){
+				tween->startVals = message->pathCurve.evaluate(0);
+				tween->endVals = message->pathCurve.evaluate(1.0);
+			}
+			cur = tween->endVals;
+		}
+	}
+
+	stable_sort(functionTweens.begin(), functionTweens.end(),
+				[](ofxTween *a, ofxTween *b){ return a->message->startDelay < b->message->startDelay; });
+
+	isResolved = true;
+}
+
+//Sets every object to where the animation has it at iTime, and stops the animation if it was running.
+void ofxAnimation::seek(float iTime)
+{
+	stop();
+	if(!isResolved) resolve();
+
+	playhead = iTime;
+	for(unsigned int t=0; t < tracks.size(); t++)
+		applyTrack(tracks[t], iTime);
+	applyBakedTracks(iTime);
+}
+
+//Plays from iFromTime at the current time scale. Needs update() every frame.
+void ofxAnimation::play(float iFromTime)
+{
+	seek(iFromTime);
+	playing = true;
+	hasUpdated = false;
+}
+
+void ofxAnimation::pause()
+{
+	playing = false;
+}
+
+void ofxAnimation::update(float iTime)
+{
+	if(!playing) return;
+
+	float prevPlayhead = playhead;
+	if(hasUpdated)
+		playhead += (iTime - lastUpdateTime)*timeScale;
+	lastUpdateTime = iTime;
+	hasUpdated = true;
+
+	for(unsigned int t=0; t < tracks.size(); t++)
+		applyTrack(tracks[t], playhead);
+	applyBakedTracks(playhead);
+	callFunctions(prevPlayhead, playhead);
+}
+
+void ofxAnimation::setTimeScale(float iScale)
+{
+	timeScale = iScale;
+}
+
+void ofxAnimation::addTween(ofxTween *iTween)
+{
+	tweens.push_back(iTween);
+	isResolved = false;
+}
+
+void ofxAnimation::evaluateTween(ofxTween *iTween, float iTime, ofVec4f &oVals)
+{
+	ofxMessage *message = iTween->message;
+	float t = (message->duration > 0) ? (iTime - message->startDelay)/message->duration : 1.0;
+	bool reversed = false;
+
+	if((message->playMode == OF_LOOP_PLAY) && (t > 1.0))
+		t = t - floorf(t);
+	else if((message->playMode == OF_LOOP_PALINDROME_PLAY) && (t > 1.0)){
+		float loop = floorf(t);
+		t = t - loop;
+		reversed = ((int)loop % 2) == 1;
+	}
+	t = MIN(MAX(t, 0), 1.0);
+
+	float e = ofxMessage::interpolateTime(message->interpolation, t);
+	//palindrome loops play their second half backwards
+	if(reversed) e = 1.0 - e;
+
+	if(message->path != OF_LINEAR_PATH)
+		oVals = message->pathCurve.evaluate(e);
+	else
+		oVals = iTween->startVals*(1.0 - e) + iTween->endVals*e;
+}
+
+//Finds the last tween on the track to have started by iTime and applies it.
+void ofxAnimation::applyTrack(ofxAnimationTrack &iTrack, float iTime)
+{
+	int i = (int)(upper_bound(iTrack.startTimes.begin(), iTrack.startTimes.end(), iTime) - iTrack.startTimes.begin()) - 1;
+	ofxObject *object = iTrack.object;
+
+	ofVec4f v = iTrack.baseVals;
+	if(iTrack.id == OF_SHOW){
+		bool shown = (i < 0) ? (iTrack.baseVals.x != 0) : (iTrack.tweens[i]->message->id == OF_SHOW);
+		v.x = shown ? 1.0 : 0;
+	}
+	else if(i >= 0)
+		evaluateTween(iTrack.tweens[i], iTime, v);
+
+	setObjectVals(object, iTrack.id, v);
+}
+
+void ofxAnimation::applyBakedTracks(float iTime)
+{
+	ofVec4f v;
+	for(unsigned int b=0; b < bakedTracks.size(); b++){
+		ofxBakedTracks *baked = bakedTracks[b];
+		for(int t=0; t < baked->getNumTracks(); t++){
+			if(!baked->objects[t]) continue;
+			baked->evaluate(t, iTime, v);
+			setObjectVals(baked->objects[t], baked->getTrackID(t), v);
+		}
+	}
+}
+
+//Calls the function tweens the playhead passed moving from iFromTime to iToTime, in the order it passed them.
+//Forwards, a function at iFromTime is called and one at iToTime is left for the next update; backwards the reverse.
+void ofxAnimation::callFunctions(float iFromTime, float iToTime)
+{
+	if(iToTime > iFromTime){
+		for(unsigned int i=0; i < functionTweens.size(); i++){
+			ofxMessage *message = functionTweens[i]->message;
+			if(message->startDelay >= iToTime) break;
+			if((message->startDelay >= iFromTime) && message->functionPtr)
+				message->functionPtr(message->functionArgs);
+		}
+	}
+	else if(iToTime < iFromTime){
+		for(int i=(int)functionTweens.size()-1; i >= 0; i--){
+			ofxMessage *message = functionTweens[i]->message;
+			if(message->startDelay <= iToTime) break;
+			if((message->startDelay <= iFromTime) && message->functionPtr)
+				message->functionPtr(message->functionArgs);
+		}
+	}
+}
+
+//Show and hide share a track. Functions have none.
+int ofxAnimation::getTrackID(int iID)
+{
+	if(iID == OF_HIDE) return OF_SHOW;
+	if((iID < 0) || (iID == OF_FUNCTION) || (iID >= OF_NUM_MESSAGE_TYPES)) return -1;
+
+	return iID;
+}
+
+ofVec4f ofxAnimation::getObjectVals(ofxObject *iObject, int iID)
+{
+	ofVec3f v;
+	switch(iID){
+		case OF_TRANSLATE:
+			v = iObject->getTrans();
+			return ofVec4f(v.x, v.y, v.z, 0);
+		case OF_ROTATE:
+			v = iObject->getRot();
+			return ofVec4f(v.x, v.y, v.z, 0);
+		case OF_SCALE:
+		case OF_SCALE3:
+			v = iObject->getScale();
+			return ofVec4f(v.x, v.y, v.z, 0);
+		case OF_SETCOLOR:
+		case OF_SETCOLOR4:
+			return iObject->getColorVec4f();
+		case OF_SETALPHA:
+			return ofVec4f(iObject->getAlpha(), 0, 0, 0);
+		case OF_SHOW:
+			return ofVec4f(iObject->isShown() ? 1.0 : 0, 0, 0, 0);
+	}
 
+	return ofVec4f(0, 0, 0, 0);
+}
+
+void ofxAnimation::setObjectVals(ofxObject *iObject, int iID, const ofVec4f &iVals)
+{
+	switch(iID){
+		case OF_TRANSLATE:
+			iObject->setTrans(iVals.x, iVals.y, iVals.z);
+			break;
+		case OF_ROTATE:
+			iObject->setRot(iVals.x, iVals.y, iVals.z);
+			break;
+		case OF_SCALE:
+			iObject->setScale(iVals.x);
+			break;
+		case OF_SCALE3:
+			iObject->setScale(iVals.x, iVals.y, iVals.z);
+			break;
+		case OF_SETCOLOR:
+			iObject->setColor(iVals.x, iVals.y, iVals.z);
+			break;
+		case OF_SETCOLOR4:
+			iObject->setColor(iVals.x, iVals.y, iVals.z, iVals.w);
+			break;
+		case OF_SETALPHA:
+			iObject->setAlpha(iVals.x);
+			break;
+		case OF_SHOW:
+			if(iVals.x != 0) iObject->show();
+			else iObject->hide();
+			break;
+	}
+}
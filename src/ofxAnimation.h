@@ -5,6 +5,13 @@
  You animate by "tweening" ofxObjects. For each tween, specify an object, a start/end time, a start/end value, and the interpolation.
  Tweens can also be played once or looped. See tweenBez and tweenSpline for creating non-linear tween paths.
  
+ start() runs the tweens as messages on their objects. Alternatively, seek() sets every object to where the animation
+ has it at a given time, without replaying what came before, and play() runs it from any time, at any speed or backwards,
+ as long as update() is called every frame. Function tweens are called by update() when the playhead crosses their time,
+ in either direction, but never by seek().
+ Relative start values are resolved once, against the objects' values when the animation is first seeked or played (see resolve()).
+ Baked keyframe tracks (see ofxBakedTracks) can be added alongside the tweens with addBakedTracks(), and are played by seek() and play() only.
+ 
  Soso OpenFrameworks Addon
  Copyright (C) 2012 Sosolimited
  
@@ -27,6 +34,7 @@
 
 #include "ofxObject.h"
 #include "ofxMessage.h"
+#include "ofxBakedTracks.h"
 
 
 
@@ -42,6 +50,20 @@ public:
 public:
 	ofxObject					*object;
 	ofxMessage				*message;
+	ofVec4f						startVals;			//resolved by ofxAnimation::resolve()
+	ofVec4f						endVals;
+};
+
+
+//Tweens that set the same property of the same object, sorted by start time.
+class ofxAnimationTrack
+{
+public:
+	ofxObject					*object;
+	int								id;
+	ofVec4f						baseVals;			//the object's values before the animation
+	vector<ofxTween *>				tweens;
+	vector<float>					startTimes;
 };
 
 
@@ -55,6 +77,16 @@ public:
 	void							stop();
 	bool							isAnimating();
 	float							getDuration();
+
+	void							resolve();
+	void							seek(float iTime);
+	void							play(float iFromTime=0);
+	void							pause();
+	void							update(float iTime);
+	bool							isPlaying(){ return playing; }
+	float							getPlayhead(){ return playhead; }
+	void							setTimeScale(float iScale);		//negative plays backwards
+	float							getTimeScale(){ return timeScale; }
   
   
 	ofxTween*					tween(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp,
@@ -79,12 +111,34 @@ public:
 	ofxTween*					showObject(ofxObject *iObject, float iTime, int iPlayMode=OF_ONE_TIME_PLAY);
 	ofxTween*					hideObject(ofxObject *iObject, float iTime, int iPlayMode=OF_ONE_TIME_PLAY);
   
-	ofxTween*					tweenBezier(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, vector<ofVec4f> iPath, int iPlayMode=OF_ONE_TIME_PLAY);
-	ofxTween*					tweenSpline(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, vector<ofVec4f> iPath, int iPlayMode=OF_ONE_TIME_PLAY);
+	ofxTween*					tweenBezier(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, const vector<ofVec4f> &iPath, int iPlayMode=OF_ONE_TIME_PLAY);
+	ofxTween*					tweenSpline(ofxObject *iObject, int iID, float iStartTime, float iEndTime, int iInterp, const vector<ofVec4f> &iPath, int iPlayMode=OF_ONE_TIME_PLAY);
   
 	ofxTween*					tweenFunc(ofxObject *iObject,float (*iFunction)(void *), void *iArgs, float iTime, int iPlayMode=OF_ONE_TIME_PLAY); //LM
+
+	void							addBakedTracks(ofxBakedTracks *iTracks);		//not owned by the animation
   
+protected:
+	void							addTween(ofxTween *iTween);
+	void							evaluateTween(ofxTween *iTween, float iTime, ofVec4f &oVals);
+	void							applyTrack(ofxAnimationTrack &iTrack, float iTime);
+	void							applyBakedTracks(float iTime);
+	void							callFunctions(float iFromTime, float iToTime);
+	static int						getTrackID(int iID);
+	static ofVec4f					getObjectVals(ofxObject *iObject, int iID);
+	static void						setObjectVals(ofxObject *iObject, int iID, const ofVec4f &iVals);
+
 public:
 	vector<ofxTween *>				tweens;
-  
+	vector<ofxAnimationTrack>		tracks;
+	vector<ofxTween *>				functionTweens;		//sorted by start time
+	vector<ofxBakedTracks *>		bakedTracks;
+
+protected:
+	bool							isResolved;
+	bool							playing;
+	bool							hasUpdated;
+	float							playhead;
+	float							lastUpdateTime;
+	float							timeScale;
 };
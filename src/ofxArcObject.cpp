@@ -1,4 +1,6 @@
 #include "ofxArcObject.h"
+#include "ofxCircleObject.h"	//for shared unit circle tables
+#include "ofxShapeRenderer.h"
 
 
 //start and end angles in degrees (converted to radians internally)
@@ -17,14 +19,33 @@ ofxArcObject::ofxArcObject(float iOuterRadius, float iInnerRadius, float iStartA
 	color1 = NULL;
 	color2 = NULL;
 	
+	isLODEnabled = false;
+	setLODParams(0.5, 8);
+	drawResolution = resolution;
+	
+	isGradientEnabled = false;
+	isShapeShaderEnabled = false;
+	
+	vbo = 0;
+	vboCapacity = 0;
+	vboBaseIndex = 0;
+	vboResolution = -1;
+	vboStartAngle = vboEndAngle = 0;
+	vboOuterRadius = vboInnerRadius = vboHeight = 0;
+	vboGradient = false;
+	meshStartAngle = meshEndAngle = 0;
+	meshFirstIndex = meshLastIndex = 0;
 }
 
 
-ofxArcObject::~ofxArcObject(){}
+ofxArcObject::~ofxArcObject(){
+	if(vbo) glDeleteBuffers(1, &vbo);
+}
 
 void ofxArcObject::setResolution(int iRes)
 {
 	resolution = iRes;
+	renderDirty = true;
 }
 
 //these are all set in degrees and converted to radians internally
@@ -51,72 +72,265 @@ void ofxArcObject::setColors(ofColor iColor1, ofColor iColor2) {
   
 	color1 = iColor1;
 	color2 = iColor2;
+	isGradientEnabled = true;
+}
+
+void ofxArcObject::setOuterRadius(float iRadius)
+{
+	outerRadius = iRadius;
+}
+
+void ofxArcObject::setInnerRadius(float iRadius)
+{
+	innerRadius = iRadius;
+}
+
+void ofxArcObject::setHeight(float iHeight)
+{
+	height = iHeight;
+}
+
+
+void ofxArcObject::enableShapeShader(bool iEnable)
+{
+	isShapeShaderEnabled = iEnable;
+}
+
+bool ofxArcObject::isBatchable()
+{
+	return isShapeShaderEnabled && !(shaderEnabled && (shader != NULL)) && ofxShapeRenderer::isSupported();
+}
+
+void ofxArcObject::enableLOD(bool iEnable)
+{
+	isLODEnabled = iEnable;
+	renderDirty = true;
+}
+
+//iTolerance is in pixels, iHysteresis is a fraction of the current draw resolution
+void ofxArcObject::setLODParams(float iTolerance, int iMinResolution, float iHysteresis)
+{
+	lodTolerance = iTolerance;
+	lodMinResolution = iMinResolution;
+	lodHysteresis = iHysteresis;
+}
+
+//Picks drawResolution from the arc's outer radius on screen. Returns true if it changed.
+bool ofxArcObject::updateLOD()
+{
+	int prevResolution = drawResolution;
+	float pixelsPerUnit = getPixelsPerUnit();
+	
+	if(!isLODEnabled || (pixelsPerUnit < 0)){
+		//disabled, or no scene projection yet
+		drawResolution = resolution;
+	}else{
+		int minRes = MIN(lodMinResolution, resolution);
+		int target = getCurveResolution(outerRadius*pixelsPerUnit, lodTolerance, minRes, resolution);
+		
+		//only switch once the ideal resolution has clearly moved away, so arcs near a threshold don't pop
+		if((target == minRes) || (target == resolution) || (drawResolution > resolution) ||
+		   (target > drawResolution*(1.0f + lodHysteresis)) || (target < drawResolution/(1.0f + lodHysteresis)))
+			drawResolution = target;
+	}
+	
+	return (drawResolution != prevResolution);
 }
 
 
 void ofxArcObject::render()
 {
+	if(isBatchable()){
+		queueBatch(&ofxShapeRenderer::flush);
+		ofxShapeRenderer::addArc(matrix, outerRadius, innerRadius, startAngle, endAngle, 0,
+		                         isGradientEnabled ? color1 : drawMaterial->color,
+		                         isGradientEnabled ? color2 : drawMaterial->color, height);
+		return;
+	}
+	
+	updateLOD();
+	
+	if(endAngle <= startAngle) return;
+	
+	updateMesh(startAngle, endAngle);
+	
 	ofFill();
+	drawMesh(isGradientEnabled);
+}
+
+//Brings the vertex buffer up to date for a sweep from iStartAngle to iEndAngle (radians).
+void ofxArcObject::updateMesh(float iStartAngle, float iEndAngle)
+{
+	//the arc is sampled on a fixed grid of angles (multiples of angleInc), clamped to [iStartAngle, iEndAngle].
+	//Anchoring the grid at 0 instead of the start angle means moving either end only touches the vertices near it.
+	float angleInc = M_TWO_PI/(float)drawResolution;
+	int firstIndex = (int)floor(iStartAngle/angleInc);
+	int lastIndex = (int)ceil(iEndAngle/angleInc);
 	
-	int k = 0;
-	float angleInc = M_TWO_PI/(float)resolution;
-	float angle = startAngle;
-	float portion = 0;
+	meshStartAngle = iStartAngle;
+	meshEndAngle = iEndAngle;
+	meshFirstIndex = firstIndex;
+	meshLastIndex = lastIndex;
 	
-	if (height > 0) {
-		
-		glBegin(GL_QUAD_STRIP);
-		while(angle < endAngle){
-			glNormal3f(cos(angle+PI), sin(angle+PI),0);
-			if (color1 != NULL && color2 != NULL) {
-				portion = 1.0 -(angle - startAngle) / (endAngle - startAngle);
-				glColor4f(portion*color1.r/255.0f + (1.0-portion)*color2.r/255.0f, portion*color1.g/255.0f + (1.0-portion)*color2.g/255.0f, portion*color1.b/255.0f + (1.0-portion)*color2.b/255.0f, portion*color1.a/255.0f + (1.0-portion)*color2.a/255.0f);
-        
-			}
-			glVertex3f(innerRadius * cos(angle), innerRadius * sin(angle), 0);
-			glVertex3f(innerRadius * cos(angle), innerRadius * sin(angle), height);
-			
-			angle += angleInc;
+	bool rebuild = (!vbo || (drawResolution != vboResolution) ||
+	                (outerRadius != vboOuterRadius) || (innerRadius != vboInnerRadius) || (height != vboHeight) ||
+	                (firstIndex < vboBaseIndex) || (lastIndex >= vboBaseIndex + vboCapacity));
+	bool colorsDirty = isGradientEnabled && ((color1 != vboColor1) || (color2 != vboColor2) ||
+	                                         (iStartAngle != vboStartAngle) || (iEndAngle != vboEndAngle) || !vboGradient);
+	
+	if(rebuild){
+		buildVertexBuffer(firstIndex, lastIndex);
+	}else{
+		//only rewrite the slots whose clamped angle moved
+		if(iStartAngle != vboStartAngle){
+			int to = MIN((int)ceil(MAX(iStartAngle, vboStartAngle)/angleInc), lastIndex);
+			updateSlots(firstIndex, to, true, false);
 		}
-		
-		//finish it
-		glNormal3f(cos(angle+PI), sin(angle+PI),0);
-		
-		if (color1 != NULL && color2 != NULL) {
-			portion = 1.0 -(angle - startAngle) / (endAngle - startAngle);
-			glColor4f(portion*color1.r/255.0f + (1.0-portion)*color2.r/255.0f, portion*color1.g/255.0f + (1.0-portion)*color2.g/255.0f, portion*color1.b/255.0f + (1.0-portion)*color2.b/255.0f, portion*color1.a/255.0f + (1.0-portion)*color2.a/255.0f);
-			
+		if(iEndAngle != vboEndAngle){
+			int from = MAX((int)floor(MIN(iEndAngle, vboEndAngle)/angleInc), firstIndex);
+			updateSlots(from, lastIndex, true, false);
+		}
+		if(colorsDirty){
+			updateSlots(firstIndex, lastIndex, false, true);
 		}
-		
-		glVertex3f(innerRadius * cos(endAngle), innerRadius * sin(endAngle), 0);
-		glVertex3f(innerRadius * cos(endAngle), innerRadius * sin(endAngle), height);
-		
-		glEnd();
-		
 	}
-	angle = startAngle;
-	glBegin(GL_QUAD_STRIP);
+	vboStartAngle = iStartAngle;
+	vboEndAngle = iEndAngle;
+	vboColor1 = color1;
+	vboColor2 = color2;
+	vboGradient = isGradientEnabled;
+}
+
+//Draws the inner side wall (if the arc has height) and the top face from the last updateMesh().
+void ofxArcObject::drawMesh(bool iColors)
+{
+	int first = 2*(meshFirstIndex - vboBaseIndex);
+	int count = 2*(meshLastIndex - meshFirstIndex + 1);
+	
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	if(iColors){
+		glEnableClientState(GL_COLOR_ARRAY);
+		glColorPointer(4, GL_FLOAT, 0, (GLvoid *)(colorOffset()*sizeof(float)));
+	}
+	
+	//inner side wall
+	if(height > 0){
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glNormalPointer(GL_FLOAT, 0, (GLvoid *)(normalOffset()*sizeof(float)));
+		glVertexPointer(3, GL_FLOAT, 0, (GLvoid *)(wallOffset()*sizeof(float)));
+		glDrawArrays(GL_TRIANGLE_STRIP, first, count);
+		glDisableClientState(GL_NORMAL_ARRAY);
+	}
+	
+	//top face
 	glNormal3f(0,0,1);
-	while(angle < endAngle){
-    
-		if (color1 != NULL && color2 != NULL) {
-			portion = 1.0 -(angle - startAngle) / (endAngle - startAngle);
-			glColor4f(portion*color1.r/255.0f + (1.0-portion)*color2.r/255.0f, portion*color1.g/255.0f + (1.0-portion)*color2.g/255.0f, portion*color1.b/255.0f + (1.0-portion)*color2.b/255.0f, portion*color1.a/255.0f + (1.0-portion)*color2.a/255.0f);
+	glVertexPointer(3, GL_FLOAT, 0, (GLvoid *)(topOffset()*sizeof(float)));
+	glDrawArrays(GL_TRIANGLE_STRIP, first, count);
+	
+	if(iColors)
+		glDisableClientState(GL_COLOR_ARRAY);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+//(Re)allocates the buffer with some slack on either side, so angle animations don't force a reallocation every frame.
+void ofxArcObject::buildVertexBuffer(int iFirstIndex, int iLastIndex)
+{
+	int margin = MAX(drawResolution/4, 1);
+	
+	vboResolution = drawResolution;
+	vboOuterRadius = outerRadius;
+	vboInnerRadius = innerRadius;
+	vboHeight = height;
+	vboBaseIndex = iFirstIndex - margin;
+	vboCapacity = (iLastIndex - iFirstIndex + 1) + 2*margin;
+	
+	vertexData.assign(colorOffset() + 8*vboCapacity, 1.0f);
+	
+	if(!vbo) glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, vertexData.size()*sizeof(float), NULL, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	
+	updateSlots(iFirstIndex, iLastIndex, true, isGradientEnabled);
+}
+
+//Writes vertices for grid indices [iFrom, iTo] into vertexData and uploads just that range.
+//Each slot holds two vertices per strip: inner/outer for the top face, bottom/top for the inner wall.
+void ofxArcObject::updateSlots(int iFrom, int iTo, bool iPositions, bool iColors)
+{
+	if(iTo < iFrom) return;
+	
+	const float *unit = ofxCircleObject::getUnitCircle(drawResolution);
+	float angleInc = M_TWO_PI/(float)drawResolution;
+	float sweep = meshEndAngle - meshStartAngle;
+	
+	//colors premultiplied by 1/255 once, instead of per vertex
+	float c1[4] = {color1.r/255.0f, color1.g/255.0f, color1.b/255.0f, color1.a/255.0f};
+	float c2[4] = {color2.r/255.0f, color2.g/255.0f, color2.b/255.0f, color2.a/255.0f};
+	
+	float *top = &vertexData[topOffset()];
+	float *wall = &vertexData[wallOffset()];
+	float *normal = &vertexData[normalOffset()];
+	float *color = &vertexData[colorOffset()];
+	
+	for(int g = iFrom; g <= iTo; g++){
+		int s = g - vboBaseIndex;
+		float angle = g*angleInc;
+		float c, sn;
+		
+		if(angle <= meshStartAngle){
+			angle = meshStartAngle;
+			c = cos(angle);
+			sn = sin(angle);
+		}else if(angle >= meshEndAngle){
+			angle = meshEndAngle;
+			c = cos(angle);
+			sn = sin(angle);
+		}else{
+			//interior vertices sit on the grid, so they can come straight from the shared table
+			int k = ((g % drawResolution) + drawResolution) % drawResolution;
+			c = unit[2*k];
+			sn = unit[2*k + 1];
 		}
-		glVertex3f(innerRadius * cos(angle), innerRadius * sin(angle), height);
-		glVertex3f(outerRadius * cos(angle), outerRadius * sin(angle), height);
 		
-		angle += angleInc;
-	}
-	//finish it
-	if (color1 != NULL && color2 != NULL) {
-		portion = 1.0 -(angle - startAngle) / (endAngle - startAngle);
-		glColor4f(portion*color1.r/255.0f + (1.0-portion)*color2.r/255.0f, portion*color1.g/255.0f + (1.0-portion)*color2.g/255.0f, portion*color1.b/255.0f + (1.0-portion)*color2.b/255.0f, portion*color1.a/255.0f + (1.0-portion)*color2.a/255.0f);
+		if(iPositions){
+			float *t = &top[6*s];
+			t[0] = innerRadius*c;  t[1] = innerRadius*sn;  t[2] = height;
+			t[3] = outerRadius*c;  t[4] = outerRadius*sn;  t[5] = height;
+			
+			float *w = &wall[6*s];
+			w[0] = innerRadius*c;  w[1] = innerRadius*sn;  w[2] = 0;
+			w[3] = innerRadius*c;  w[4] = innerRadius*sn;  w[5] = height;
+			
+			//walls face the center
+			float *n = &normal[6*s];
+			n[0] = -c;  n[1] = -sn;  n[2] = 0;
+			n[3] = -c;  n[4] = -sn;  n[5] = 0;
+		}
 		
+		if(iColors){
+			float portion = 1.0f - (angle - meshStartAngle)/sweep;
+			float *col = &color[8*s];
+			for(int i = 0; i < 4; i++){
+				col[i] = portion*c1[i] + (1.0f - portion)*c2[i];
+				col[i+4] = col[i];
+			}
+		}
 	}
-	glVertex3f(innerRadius * cos(endAngle), innerRadius * sin(endAngle), height);
-	glVertex3f(outerRadius * cos(endAngle), outerRadius * sin(endAngle), height);
 	
-	glEnd();
+	int from = iFrom - vboBaseIndex;
+	int num = iTo - iFrom + 1;
 	
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	if(iPositions){
+		glBufferSubData(GL_ARRAY_BUFFER, (topOffset() + 6*from)*sizeof(float), 6*num*sizeof(float), &top[6*from]);
+		glBufferSubData(GL_ARRAY_BUFFER, (wallOffset() + 6*from)*sizeof(float), 6*num*sizeof(float), &wall[6*from]);
+		glBufferSubData(GL_ARRAY_BUFFER, (normalOffset() + 6*from)*sizeof(float), 6*num*sizeof(float), &normal[6*from]);
+	}
+	if(iColors){
+		glBufferSubData(GL_ARRAY_BUFFER, (colorOffset() + 8*from)*sizeof(float), 8*num*sizeof(float), &color[8*from]);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
\ No newline at end of file
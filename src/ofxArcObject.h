@@ -18,7 +18,28 @@ public:
   float getStartAngle(); //LM 062012
   float getEndAngle(); //LM 062012
 	void  setColors(ofColor iColor1, ofColor iColor2);
+  void  setOuterRadius(float iRadius);
+  void  setInnerRadius(float iRadius);
+  void  setHeight(float iHeight);
+  
+  void  enableLOD(bool iEnable);  //off by default; adapts the drawn resolution to the size on screen
+  void  setLODParams(float iTolerance, int iMinResolution, float iHysteresis=0.25);
+  int   getDrawResolution(){ return drawResolution; }
+  void  enableShapeShader(bool iEnable);
+  bool  isBatchable();
 	
+protected:
+  bool  updateLOD();
+  void  buildVertexBuffer(int iFirstIndex, int iLastIndex);
+  void  updateMesh(float iStartAngle, float iEndAngle);
+  void  drawMesh(bool iColors);
+  void  updateSlots(int iFrom, int iTo, bool iPositions, bool iColors);
+  
+  //offsets (in floats) of each array in the vertex buffer
+  int   topOffset(){ return 0; }
+  int   wallOffset(){ return 6*vboCapacity; }
+  int   normalOffset(){ return 12*vboCapacity; }
+  int   colorOffset(){ return 18*vboCapacity; }
   
 public:
   
@@ -31,5 +52,35 @@ public:
   ofColor color1, color2;
 	float height;
   
+  //level of detail: the number of segments drawn adapts to the arc's size on screen, never exceeding resolution
+  bool  isLODEnabled;
+  float lodTolerance,   //max deviation from a true circle, in pixels
+        lodHysteresis;  //how far (as a fraction) the ideal resolution must drift before switching
+  int   lodMinResolution,
+        drawResolution; //resolution picked by LOD, used for drawing
+  
+  bool  isGradientEnabled;  //set by setColors()
+  bool  isShapeShaderEnabled; //draw the top face as one anti-aliased quad with ofxShapeRenderer (no side walls)
+  
+protected:
+  //the mesh lives in a vertex buffer and is only rewritten where the arc's parameters changed
+  GLuint        vbo;
+  int           vboCapacity,    //number of angle slots allocated
+                vboBaseIndex,   //angle grid index of slot 0
+                vboResolution;
+  float         vboStartAngle,
+                vboEndAngle,
+                vboOuterRadius,
+                vboInnerRadius,
+                vboHeight;
+  ofColor       vboColor1,
+                vboColor2;
+  bool          vboGradient;
+  float         meshStartAngle,   //sweep the buffer was last updated for
+                meshEndAngle;
+  int           meshFirstIndex,
+                meshLastIndex;
+  vector<float> vertexData;
+  
   
 };
@@ -0,0 +1,262 @@
+#include "ofxBakedTracks.h"
+#include "ofxObject.h"
+#include "ofUtils.h"
+#include <fstream>
+
+#ifndef TARGET_WIN32
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+ofxBakedTracks::ofxBakedTracks()
+{
+	data = NULL;
+	size = 0;
+	mapping = NULL;
+	header = NULL;
+	tracks = NULL;
+	segments = NULL;
+	values = NULL;
+	names = NULL;
+}
+
+ofxBakedTracks::~ofxBakedTracks()
+{
+	unload();
+}
+
+//Maps the file at iPath into memory. On Windows it is read into a buffer instead.
+bool ofxBakedTracks::load(string iPath)
+{
+	unload();
+	string path = ofToDataPath(iPath);
+
+#ifndef TARGET_WIN32
+	int fd = open(path.c_str(), O_RDONLY);
+	if(fd < 0){
+		ofLogError("ofxBakedTracks") << "couldn't open " << path;
+		return false;
+	}
+	struct stat info;
+	if((fstat(fd, &info) == 0) && (info.st_size > 0)){
+		void *m = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(m != MAP_FAILED){
+			mapping = m;
+			data = (const char *)m;
+			size = (size_t)info.st_size;
+		}
+	}
+	close(fd);
+#else
+	ifstream file(path.c_str(), ios::binary);
+	if(file){
+		buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+		data = buffer.empty() ? NULL : &buffer[0];
+		size = buffer.size();
+	}
+#endif
+
+	if(!data || !validate()){
+		ofLogError("ofxBakedTracks") << "couldn't load " << path;
+		unload();
+		return false;
+	}
+
+	return true;
+}
+
+bool ofxBakedTracks::setData(vector<char> &iData)
+{
+	unload();
+	buffer.swap(iData);
+	data = buffer.empty() ? NULL : &buffer[0];
+	size = buffer.size();
+
+	if(!data || !validate()){
+		ofLogError("ofxBakedTracks") << "invalid track data";
+		unload();
+		return false;
+	}
+
+	return true;
+}
+
+bool ofxBakedTracks::save(string iPath)
+{
+	if(!data) return false;
+
+	string path = ofToDataPath(iPath);
+	ofstream file(path.c_str(), ios::binary);
+	file.write(data, size);
+	if(!file){
+		ofLogError("ofxBakedTracks") << "couldn't write " << path;
+		return false;
+	}
+
+	return true;
+}
+
+void ofxBakedTracks::unload()
+{
+#ifndef TARGET_WIN32
+	if(mapping) munmap(mapping, size);
+#endif
+	mapping = NULL;
+	buffer.clear();
+	data = NULL;
+	size = 0;
+	header = NULL;
+	tracks = NULL;
+	segments = NULL;
+	values = NULL;
+	names = NULL;
+	objects.clear();
+	cursors.clear();
+}
+
+//Binds every track of the layers named iLayerName to iObject, and returns how many were bound.
+int ofxBakedTracks::bind(string iLayerName, ofxObject *iObject)
+{
+	int count = 0;
+	for(int i=0; i < getNumTracks(); i++){
+		if(iLayerName == names + tracks[i].nameOffset){
+			objects[i] = iObject;
+			count++;
+		}
+	}
+
+	return count;
+}
+
+//Sets oVals to the value of iTrack at iTime. Channels the track doesn't have are left alone.
+void ofxBakedTracks::evaluate(int iTrack, float iTime, ofVec4f &oVals)
+{
+	const ofxBakedTrack &track = tracks[iTrack];
+	const ofxBakedSegment &segment = segments[findSegment(iTrack, iTime)];
+	const float *v = values + segment.firstValue;
+	int numChannels = (int)track.numChannels;
+
+	float u = (segment.duration > 0) ? (iTime - segment.startTime)/segment.duration : 0;
+	u = MIN(MAX(u, 0), 1.0);
+
+	switch(segment.type){
+		case OF_BAKED_HOLD:
+			for(int c=0; c < numChannels; c++)
+				oVals[c] = v[c];
+			break;
+		case OF_BAKED_CUBIC:
+			for(int c=0; c < numChannels; c++, v += 4)
+				oVals[c] = v[0] + u*(v[1] + u*(v[2] + u*v[3]));
+			break;
+		case OF_BAKED_SAMPLED:{
+			float s = u*(segment.numSamples - 1);
+			int i = MIN((int)s, (int)segment.numSamples - 2);
+			float f = s - i;
+			const float *a = v + i*numChannels;
+			const float *b = a + numChannels;
+			for(int c=0; c < numChannels; c++)
+				oVals[c] = a[c] + (b[c] - a[c])*f;
+			break;
+		}
+	}
+}
+
+//Checks the header and every offset once, so evaluate() doesn't have to.
+bool ofxBakedTracks::validate()
+{
+	if(size < sizeof(ofxBakedTracksHeader)) return false;
+	header = (const ofxBakedTracksHeader *)data;
+	if(memcmp(header->magic, "SOTK", 4) != 0){
+		header = NULL;
+		return false;
+	}
+	if(header->version != OF_BAKED_TRACKS_VERSION){
+		ofLogError("ofxBakedTracks") << "unsupported version " << header->version;
+		header = NULL;
+		return false;
+	}
+
+	uint64_t offset = sizeof(ofxBakedTracksHeader);
+	uint64_t tracksOffset = offset;
+	offset += (uint64_t)header->numTracks*sizeof(ofxBakedTrack);
+	uint64_t segmentsOffset = offset;
+	offset += (uint64_t)header->numSegments*sizeof(ofxBakedSegment);
+	uint64_t valuesOffset = offset;
+	offset += (uint64_t)header->numValues*sizeof(float);
+	uint64_t namesOffset = offset;
+	offset += header->namesSize;
+	if((offset != size) || (header->namesSize == 0) || (data[size - 1] != '\0')){
+		header = NULL;
+		return false;
+	}
+
+	tracks = (const ofxBakedTrack *)(data + tracksOffset);
+	segments = (const ofxBakedSegment *)(data + segmentsOffset);
+	values = (const float *)(data + valuesOffset);
+	names = data + namesOffset;
+
+	for(unsigned int i=0; i < header->numTracks; i++){
+		const ofxBakedTrack &track = tracks[i];
+		if((track.nameOffset >= header->namesSize) || (track.numChannels < 1) || (track.numChannels > 4) ||
+		   (track.numSegments == 0) || ((uint64_t)track.firstSegment + track.numSegments > header->numSegments)){
+			header = NULL;
+			return false;
+		}
+
+		for(unsigned int s=track.firstSegment; s < track.firstSegment + track.numSegments; s++){
+			const ofxBakedSegment &segment = segments[s];
+			uint64_t numValues = 0;
+			if(segment.type == OF_BAKED_HOLD)
+				numValues = track.numChannels;
+			else if(segment.type == OF_BAKED_CUBIC)
+				numValues = 4*track.numChannels;
+			else if((segment.type == OF_BAKED_SAMPLED) && (segment.numSamples >= 2))
+				numValues = (uint64_t)segment.numSamples*track.numChannels;
+			if((numValues == 0) || (segment.firstValue + numValues > header->numValues) ||
+			   ((s > track.firstSegment) && (segment.startTime < segments[s - 1].startTime))){
+				header = NULL;
+				return false;
+			}
+		}
+	}
+
+	objects.assign(header->numTracks, (ofxObject *)NULL);
+	cursors.resize(header->numTracks);
+	for(unsigned int i=0; i < header->numTracks; i++)
+		cursors[i] = (int)tracks[i].firstSegment;
+
+	return true;
+}
+
+//Finds the last segment of iTrack to start by iTime, or the first one if none has.
+//Checks the last segment found and its neighbours before searching.
+int ofxBakedTracks::findSegment(int iTrack, float iTime)
+{
+	const ofxBakedTrack &track = tracks[iTrack];
+	int first = (int)track.firstSegment;
+	int last = first + (int)track.numSegments - 1;
+	int cursor = cursors[iTrack];
+
+	for(int step=0; step < 3; step++){
+		int s = cursor + ((step == 0) ? 0 : (step == 1) ? 1 : -1);
+		if((s < first) || (s > last)) continue;
+		bool started = (s == first) || (segments[s].startTime <= iTime);
+		bool ended = (s < last) && (segments[s + 1].startTime <= iTime);
+		if(started && !ended){
+			cursors[iTrack] = s;
+			return s;
+		}
+	}
+
+	int lo = first, hi = last;
+	while(lo < hi){
+		int mid = (lo + hi + 1)/2;
+		if(segments[mid].startTime <= iTime) lo = mid;
+		else hi = mid - 1;
+	}
+	cursors[iTrack] = lo;
+
+	return lo;
+}
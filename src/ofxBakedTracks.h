@@ -0,0 +1,123 @@
+/*
+ofxBakedTracks
+
+Keyframed property tracks in a compact binary file, usually baked from an After Effects/Lottie export by ofxLottieImporter.
+Each track animates one property of one layer (OF_TRANSLATE, OF_ROTATE, OF_SCALE3, OF_SETCOLOR, OF_SETALPHA or OF_SHOW)
+as a list of segments, each one of:
+OF_BAKED_HOLD - a constant value.
+OF_BAKED_CUBIC - a cubic polynomial per channel in the segment's normalized time. Linear keys and most eases are exact.
+OF_BAKED_SAMPLED - evenly spaced samples, interpolated linearly. Used for eases and motion paths a cubic can't match.
+load() maps the file into memory, and evaluate() reads it in place. Every track remembers the segment it last evaluated,
+so playing forwards or backwards costs O(1) per track per frame. Jumps fall back to a binary search.
+Bind layers to objects with bind(), and play them with ofxAnimation::addBakedTracks().
+
+File layout, little endian: ofxBakedTracksHeader, then numTracks ofxBakedTrack, numSegments ofxBakedSegment,
+numValues floats, and namesSize bytes of null-terminated layer names.
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "ofConstants.h"
+#include "ofxMessage.h"
+#include <stdint.h>
+
+class ofxObject;
+
+#define OF_BAKED_TRACKS_VERSION		1
+
+enum
+{
+	OF_BAKED_HOLD,
+	OF_BAKED_CUBIC,
+	OF_BAKED_SAMPLED
+};
+
+struct ofxBakedTracksHeader
+{
+	char							magic[4];		//"SOTK"
+	uint32_t						version;
+	uint32_t						numTracks;
+	uint32_t						numSegments;
+	uint32_t						numValues;
+	uint32_t						namesSize;
+	float							duration;		//seconds
+	float							frameRate;		//of the source composition
+};
+
+struct ofxBakedTrack
+{
+	uint32_t						nameOffset;		//into the names
+	int32_t							id;				//message type of the property
+	uint32_t						numChannels;
+	uint32_t						firstSegment;
+	uint32_t						numSegments;
+};
+
+//Values are numChannels floats for a hold, 4 coefficients per channel for a cubic (v = a + b*u + c*u^2 + d*u^3),
+//or numSamples*numChannels floats for samples.
+struct ofxBakedSegment
+{
+	float							startTime;
+	float							duration;		//0 for the hold at the end of a track
+	uint32_t						type;
+	uint32_t						numSamples;
+	uint32_t						firstValue;
+};
+
+class ofxBakedTracks
+{
+public:
+	ofxBakedTracks();
+	~ofxBakedTracks();
+
+	bool							load(string iPath);
+	bool							setData(vector<char> &iData);		//takes the contents of iData
+	bool							save(string iPath);
+	void							unload();
+	bool							isLoaded(){ return header != NULL; }
+
+	int								getNumTracks(){ return header ? (int)header->numTracks : 0; }
+	float							getDuration(){ return header ? header->duration : 0; }
+	float							getFrameRate(){ return header ? header->frameRate : 0; }
+	string							getLayerName(int iTrack){ return string(names + tracks[iTrack].nameOffset); }
+	int								getTrackID(int iTrack){ return tracks[iTrack].id; }
+
+	int								bind(string iLayerName, ofxObject *iObject);
+	void							evaluate(int iTrack, float iTime, ofVec4f &oVals);
+
+protected:
+	bool							validate();
+	int								findSegment(int iTrack, float iTime);
+
+public:
+	vector<ofxObject *>				objects;		//bound object of each track, or NULL
+
+protected:
+	const char						*data;
+	size_t							size;
+	vector<char>					buffer;			//used instead of a mapping by setData(), and on Windows
+	void							*mapping;
+	const ofxBakedTracksHeader		*header;
+	const ofxBakedTrack				*tracks;
+	const ofxBakedSegment			*segments;
+	const float						*values;
+	const char						*names;
+	vector<int>						cursors;		//last segment evaluated on each track
+};
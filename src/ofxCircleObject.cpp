@@ -1,5 +1,7 @@
 #include "ofxCircleObject.h"
+#include "ofxShapeRenderer.h"
 
+map<int, vector<float> > ofxCircleObject::unitCircles;
 
 ofxCircleObject::ofxCircleObject(int iResolution, float iOuterRadius, float iInnerRadius)
 {
@@ -8,28 +10,134 @@ ofxCircleObject::ofxCircleObject(int iResolution, float iOuterRadius, float iInn
 	outerRadius = iOuterRadius;
 	innerRadius = iInnerRadius;	
 
-	numCirclePoints = 4*resolution;
-	circlePoints = new float[numCirclePoints];
+	isLODEnabled = false;
+	setLODParams(0.5, 8);
+	drawResolution = resolution;
+	isShapeShaderEnabled = false;
 
-	
+	vbo = 0;
+	vboResolution = -1;
+	vboOuterRadius = 0;
+	vboInnerRadius = 0;
 }
 
 ofxCircleObject::~ofxCircleObject(){
-  delete[] circlePoints;
+  if(vbo) glDeleteBuffers(1, &vbo);
 }
 
 void ofxCircleObject::render()
 {		
+	if(isBatchable()){
+		queueBatch(&ofxShapeRenderer::flush);
+		ofxShapeRenderer::addArc(matrix, outerRadius, innerRadius, 0, M_TWO_PI, 0, drawMaterial->color, drawMaterial->color);
+		return;
+	}
+
+	updateLOD();
+
+	if((drawResolution != vboResolution) || (outerRadius != vboOuterRadius) || (innerRadius != vboInnerRadius))
+		buildVertexBuffer();
+
 	ofFill();			
 
-	int k = 0;
-	float angleInc = M_TWO_PI/(float)resolution;
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(2, GL_FLOAT, 0, 0);
+	glDrawArrays(GL_TRIANGLE_STRIP, 0, 2*(drawResolution+1));
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+//Fills the buffer with a triangle strip alternating between inner and outer radius.
+void ofxCircleObject::buildVertexBuffer()
+{
+	const float *unit = getUnitCircle(drawResolution);
+	int numVerts = 2*(drawResolution+1);
+
+	vertexData.resize(2*numVerts);
+	for(int i = 0; i < (drawResolution+1); i++){
+		vertexData[4*i]     = innerRadius * unit[2*i];
+		vertexData[4*i + 1] = innerRadius * unit[2*i + 1];
+		vertexData[4*i + 2] = outerRadius * unit[2*i];
+		vertexData[4*i + 3] = outerRadius * unit[2*i + 1];
+	}
+
+	if(!vbo) glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	if(drawResolution == vboResolution)
+		glBufferSubData(GL_ARRAY_BUFFER, 0, vertexData.size()*sizeof(float), &vertexData[0]);
+	else
+		glBufferData(GL_ARRAY_BUFFER, vertexData.size()*sizeof(float), &vertexData[0], GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	vboResolution = drawResolution;
+	vboOuterRadius = outerRadius;
+	vboInnerRadius = innerRadius;
+}
+
+//Returns iResolution+1 (cos, sin) pairs around the unit circle, shared by all circles of that resolution.
+//The last pair repeats the first so rings close without a seam.
+const float* ofxCircleObject::getUnitCircle(int iResolution)
+{
+	vector<float> &table = unitCircles[iResolution];
+
+	if(table.empty()){
+		table.resize(2*(iResolution+1));
+		for(int i = 0; i < iResolution; i++){
+			double angle = M_TWO_PI*(double)i/(double)iResolution;
+			table[2*i] = (float)cos(angle);
+			table[2*i + 1] = (float)sin(angle);
+		}
+		table[2*iResolution] = table[0];
+		table[2*iResolution + 1] = table[1];
+	}
+
+	return &table[0];
+}
 
-	glBegin(GL_TRIANGLE_STRIP);
-	for(int i = 0; i < (resolution+1); i++){		
-		float angle = (float)i*angleInc;
-		glVertex3f(innerRadius * cos(angle), innerRadius * sin(angle), 0);
-		glVertex3f(outerRadius * cos(angle), outerRadius * sin(angle), 0);				
+//Draw as one quad, with the outline worked out per pixel, instead of a tessellated ring.
+void ofxCircleObject::enableShapeShader(bool iEnable)
+{
+	isShapeShaderEnabled = iEnable;
+}
+
+//Shaders are bound per object, so circles with their own shader can't use the shape shader.
+bool ofxCircleObject::isBatchable()
+{
+	return isShapeShaderEnabled && !(shaderEnabled && (shader != NULL)) && ofxShapeRenderer::isSupported();
+}
+
+void ofxCircleObject::enableLOD(bool iEnable)
+{
+	isLODEnabled = iEnable;
+}
+
+//iTolerance is in pixels, iHysteresis is a fraction of the current draw resolution
+void ofxCircleObject::setLODParams(float iTolerance, int iMinResolution, float iHysteresis)
+{
+	lodTolerance = iTolerance;
+	lodMinResolution = iMinResolution;
+	lodHysteresis = iHysteresis;
+}
+
+//Picks drawResolution from the circle's radius on screen. Returns true if it changed.
+bool ofxCircleObject::updateLOD()
+{
+	int prevResolution = drawResolution;
+	float pixelsPerUnit = getPixelsPerUnit();
+
+	if(!isLODEnabled || (pixelsPerUnit < 0)){
+		//disabled, or no scene projection yet
+		drawResolution = resolution;
+	}else{
+		int minRes = MIN(lodMinResolution, resolution);
+		int target = getCurveResolution(outerRadius*pixelsPerUnit, lodTolerance, minRes, resolution);
+
+		//only switch once the ideal resolution has clearly moved away, so circles near a threshold don't pop
+		if((target == minRes) || (target == resolution) || (drawResolution > resolution) ||
+		   (target > drawResolution*(1.0f + lodHysteresis)) || (target < drawResolution/(1.0f + lodHysteresis)))
+			drawResolution = target;
 	}
-	glEnd();
+
+	return (drawResolution != prevResolution);
 }
\ No newline at end of file
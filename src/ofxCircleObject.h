@@ -2,6 +2,11 @@
 ofxCircleObject
 
 Simple ofxObject that draws a circle. You can also draw a ring by specifying a non-zero inner radius.
+Circles draw resolution segments. Call enableLOD(true) to have the number of segments adapt to the
+circle's size on screen instead, never exceeding resolution.
+The ring is built into a vertex buffer from shared unit circle tables, and only rebuilt when
+the radii or the drawn resolution change.
+Call enableShapeShader() to draw it as a single anti-aliased quad with ofxShapeRenderer instead.
 
 Soso OpenFrameworks Addon
 Copyright (C) 2012 Sosolimited
@@ -35,12 +40,37 @@ public:
   void setResolution(int iResolution) {
     resolution = iResolution;
   }
+  void            enableLOD(bool iEnable);    //off by default
+  void            setLODParams(float iTolerance, int iMinResolution, float iHysteresis=0.25);
+  int             getDrawResolution(){ return drawResolution; }
+  void            enableShapeShader(bool iEnable);
+  bool            isBatchable();
+  
+  static const float* getUnitCircle(int iResolution);
+
+protected:
+  bool            updateLOD();
+  void            buildVertexBuffer();
 
 public:	
-	int							resolution,
-                  numCirclePoints;
+	int							resolution;
 	float						outerRadius,
                   innerRadius;
-	float						*circlePoints;
+  
+  bool            isLODEnabled;
+  float           lodTolerance,     //max deviation from a true circle, in pixels
+                  lodHysteresis;    //how far (as a fraction) the ideal resolution must drift before switching
+  int             lodMinResolution,
+                  drawResolution;   //resolution picked by LOD, used for drawing
+  bool            isShapeShaderEnabled;
+  
+protected:
+  GLuint          vbo;
+  int             vboResolution;    //what the buffer was last built with
+  float           vboOuterRadius,
+                  vboInnerRadius;
+  vector<float>   vertexData;
+  
+  static map<int, vector<float> > unitCircles;   //cos/sin pairs, keyed by resolution
 
 };
@@ -0,0 +1,92 @@
+#include "ofxClock.h"
+#include "ofAppRunner.h"	//for ofGetElapsedTimef()
+
+ofxClock* ofxClock::current = NULL;
+
+ofxClock::ofxClock()
+{
+	time = 0;
+	deltaTime = 0;
+	frameNum = 0;
+	timeScale = 1.0;
+	paused = false;
+	fixedTimeStep = false;
+	timeStep = 1.0/30.0;
+	lastSource = 0;
+	hasSource = false;
+}
+
+ofxClock::~ofxClock()
+{
+	if(current == this)
+		current = NULL;
+}
+
+//Advances the clock by one frame.
+void ofxClock::update()
+{
+	float dt = 0;
+	if(fixedTimeStep)
+		dt = timeStep;
+	else{
+		float source = readSource();
+		//the first reading sets the clock, so it starts out matching its source
+		if(!hasSource) time = source;
+		else dt = source - lastSource;
+		lastSource = source;
+		hasSource = true;
+	}
+
+	if(paused) dt = 0;
+	deltaTime = dt*timeScale;
+	time += deltaTime;
+	frameNum++;
+}
+
+//Jumps to iTime. ofxScene::update(iTime) uses this to run on time it's handed.
+void ofxClock::setTime(float iTime)
+{
+	deltaTime = iTime - time;
+	time = iTime;
+	frameNum++;
+}
+
+void ofxClock::setTimeScale(float iScale)
+{
+	timeScale = iScale;
+}
+
+void ofxClock::pause(bool iPause)
+{
+	paused = iPause;
+}
+
+//Each frame advances exactly iStep seconds (scaled). Turning it off picks the source back up from where it is now.
+void ofxClock::enableFixedTimeStep(bool iEnable, float iStep)
+{
+	fixedTimeStep = iEnable;
+	timeStep = iStep;
+	hasSource = false;
+	if(!iEnable){
+		lastSource = readSource();
+		hasSource = true;
+	}
+}
+
+//The clock of the scene updated last. Messages and animations created outside an update start on it.
+void ofxClock::setCurrent(ofxClock *iClock)
+{
+	current = iClock;
+}
+
+float ofxClock::getCurrentTime()
+{
+	if(current) return current->getTime();
+
+	return ofGetElapsedTimef();
+}
+
+float ofxClock::readSource()
+{
+	return ofGetElapsedTimef();
+}
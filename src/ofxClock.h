@@ -0,0 +1,71 @@
+/*
+ofxClock
+
+The time a scene runs on. ofxScene::update() advances its clock once per frame, and messages, animations,
+scrollers and state machines all read scene time from it instead of the wall clock.
+By default the clock follows ofGetElapsedTimef(), scaled by setTimeScale() and stopped by pause().
+With enableFixedTimeStep(), every frame advances exactly one step whatever the real frame time is, which
+makes runs repeatable and lets you render frame-accurate output offline as fast (or slow) as the machine draws.
+To follow another source, like timecode or an audio player, subclass and override readSource().
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF 
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+class ofxClock
+{
+public:
+	ofxClock();
+	virtual ~ofxClock();
+
+	virtual void			update();
+	void					setTime(float iTime);
+	float					getTime(){ return time; }
+	float					getDeltaTime(){ return deltaTime; }
+	int						getFrameNum(){ return frameNum; }
+
+	void					setTimeScale(float iScale);
+	float					getTimeScale(){ return timeScale; }
+	void					pause(bool iPause=true);
+	bool					isPaused(){ return paused; }
+
+	void					enableFixedTimeStep(bool iEnable, float iStep=1.0/30.0);
+	bool					isFixedTimeStep(){ return fixedTimeStep; }
+	float					getTimeStep(){ return timeStep; }
+
+	static void				setCurrent(ofxClock *iClock);
+	static ofxClock*		getCurrent(){ return current; }
+	static float			getCurrentTime();
+
+protected:
+	virtual float			readSource();
+
+protected:
+	float					time;
+	float					deltaTime;
+	int						frameNum;
+	float					timeScale;
+	bool					paused;
+	bool					fixedTimeStep;
+	float					timeStep;
+	float					lastSource;
+	bool					hasSource;
+
+	static ofxClock			*current;
+};
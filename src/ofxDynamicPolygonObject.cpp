@@ -1,40 +1,141 @@
 #include "ofxDynamicPolygonObject.h"
 
-ofxDynamicPolygonObject::ofxDynamicPolygonObject(int iNumVertices):ofxPolygonObject(iNumVertices)
+//class ofxVertexTweens
+
+void ofxVertexTweens::setup(int iNumVertices, int iNumComponents, float iInitVal)
 {
-	for(int i=0; i < numVertices; i++){
+	numVertices = iNumVertices;
+	numComponents = iNumComponents;
+	numActive = 0;
+	isDirty = true;
+
+	cur.assign(numVertices*numComponents, iInitVal);
+	start = cur;
+	end = cur;
+	startTimes.assign(numVertices, 0);
+	durations.assign(numVertices, 1.0f);
+	progress.assign(numVertices, 0);
+	interps.assign(numVertices, OF_LINEAR);
+	active.assign(numVertices, 0);
+}
 
-		ofxDynamicPolygonVert *v = new ofxDynamicPolygonVert();
-		v->posTracker = new ofxObject();
-		addChild(v->posTracker);
-		v->texTracker = new ofxObject();
-		addChild(v->texTracker);
-		v->colorTracker = new ofxObject();
-		v->colorTracker->setColor(255, 255, 255, 255);
-		addChild(v->colorTracker);
+//Sets a vertex immediately, cancelling any tween on it.
+void ofxVertexTweens::setValue(int iVertexNum, const float *iVals)
+{
+	if(active[iVertexNum]){
+		active[iVertexNum] = 0;
+		numActive--;
+	}
+	for(int c=0; c < numComponents; c++){
+		int i = c*numVertices + iVertexNum;
+		cur[i] = start[i] = end[i] = iVals[c];
+	}
+	isDirty = true;
+}
 
-		dynamicVerts.push_back(v);
+//Tweens a vertex from its current value, replacing any tween already on it.
+void ofxVertexTweens::tween(int iVertexNum, const float *iVals, float iStartTime, float iDur, int iInterp)
+{
+	if(!active[iVertexNum]){
+		active[iVertexNum] = 1;
+		numActive++;
+	}
+	for(int c=0; c < numComponents; c++){
+		int i = c*numVertices + iVertexNum;
+		start[i] = cur[i];
+		end[i] = iVals[c];
 	}
+	startTimes[iVertexNum] = iStartTime;
+	durations[iVertexNum] = MAX(iDur, 0.000001f);
+	interps[iVertexNum] = iInterp;
 }
 
-ofxDynamicPolygonObject::~ofxDynamicPolygonObject(){
-  for (auto vert : dynamicVerts){
-    delete vert->posTracker;
-    delete vert->texTracker;
-    delete vert->colorTracker;
-    delete vert;                //DEV: should this be: delete[] vert?
-  }
-  dynamicVerts.clear();
-//  delete dynamicVerts;    //DEV: why cant i delete this
+//Evaluates all tweens at iTime. Returns true if any values changed.
+//Finished and idle vertices keep start == end, so the time and lerp loops run over every vertex without skipping any.
+bool ofxVertexTweens::update(float iTime)
+{
+	bool changed = isDirty;
+	isDirty = false;
+	if(numActive == 0) return changed;
+
+	int n = numVertices;
+	float *p = &progress[0];
+	const float *st = &startTimes[0];
+	const float *du = &durations[0];
+
+	//normalized time
+	for(int i=0; i < n; i++){
+		float t = (iTime - st[i])/du[i];
+		p[i] = MIN(MAX(t, 0.0f), 1.0f);
+	}
+
+	//easing switches on the curve once per run of vertices sharing it, not per vertex,
+	//so vertices tweened together with the same curve are eased in one pass
+	ofxMessage::interpolateTimes(&interps[0], p, p, n);
+
+	//interpolate every component
+	for(int c=0; c < numComponents; c++){
+		float *v = &cur[c*n];
+		const float *s = &start[c*n];
+		const float *e = &end[c*n];
+		for(int i=0; i < n; i++)
+			v[i] = s[i] + (e[i] - s[i])*p[i];
+	}
+
+	//retire finished tweens
+	for(int i=0; i < n; i++){
+		if(active[i] && (iTime >= st[i] + du[i])){
+			active[i] = 0;
+			numActive--;
+			for(int c=0; c < numComponents; c++)
+				start[c*n + i] = cur[c*n + i] = end[c*n + i];
+		}
+	}
+
+	return true;
 }
 
+
+//class ofxDynamicPolygonObject
+
+ofxDynamicPolygonObject::ofxDynamicPolygonObject(int iNumVertices):ofxPolygonObject(iNumVertices)
+{
+	posTweens.setup(numVertices, 3, 0);
+	texTweens.setup(numVertices, 2, 0);
+	colorTweens.setup(numVertices, 4, 255);
+}
+
+ofxDynamicPolygonObject::~ofxDynamicPolygonObject(){}
+
 void ofxDynamicPolygonObject::idle(float iTime)
 {	
-	for(int i=0; i < numVertices; i++){
-		ofxPolygonObject::setVertexPos(i, dynamicVerts[i]->posTracker->getTrans());
-		ofxPolygonObject::setVertexTexCoords(i, dynamicVerts[i]->texTracker->getTrans().x, dynamicVerts[i]->texTracker->getTrans().y);
-		if(vertexColoringEnabled)
-			ofxPolygonObject::setVertexColor(i, dynamicVerts[i]->colorTracker->getColor().r, dynamicVerts[i]->colorTracker->getColor().g, dynamicVerts[i]->colorTracker->getColor().b, dynamicVerts[i]->colorTracker->getColor().a);
+	//messages run on ofxObject::curTime, so vertex tweens do too
+	float time = curTime;
+
+	if(posTweens.update(time)){
+		for(int c=0; c < 3; c++){
+			for(int i=0; i < numVertices; i++)
+				vertices[3*i + c] = posTweens.get(i, c);
+		}
+		markPositionsDirty(0, numVertices-1);
+	}
+
+	if(texTweens.update(time)){
+		for(int i=0; i < numVertices; i++)
+			ofxPolygonObject::setVertexTexCoords(i, texTweens.get(i, 0), texTweens.get(i, 1));
+	}
+
+	//colors are rewritten every frame while enabled, since they include the object's alpha
+	colorTweens.update(time);
+	if(vertexColoringEnabled){
+		float alpha = drawMaterial->color.a/255.0f;
+		for(int i=0; i < numVertices; i++){
+			vertexColors[4*i] = colorTweens.get(i, 0)/255.0f;
+			vertexColors[4*i + 1] = colorTweens.get(i, 1)/255.0f;
+			vertexColors[4*i + 2] = colorTweens.get(i, 2)/255.0f;
+			vertexColors[4*i + 3] = alpha * colorTweens.get(i, 3)/255.0f;
+		}
+		vertexBuffer.markColorsDirty(0, numVertices-1);
 	}
 }
 
@@ -42,16 +143,16 @@ void ofxDynamicPolygonObject::idle(float iTime)
 void ofxDynamicPolygonObject::setVertexPos(int iVertexNum, ofVec3f iPos)
 {
 	if((iVertexNum >= 0) && (iVertexNum < numVertices)){		
-		dynamicVerts[iVertexNum]->posTracker->stopMessages();				
-		dynamicVerts[iVertexNum]->posTracker->setTrans(iPos);
+		float vals[3] = {iPos.x, iPos.y, iPos.z};
+		posTweens.setValue(iVertexNum, vals);
 	}
 }
 
 void ofxDynamicPolygonObject::setVertexTexCoords(int iVertexNum, float iU, float iV)
 {
 	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
-		dynamicVerts[iVertexNum]->texTracker->stopMessages();		
-		dynamicVerts[iVertexNum]->texTracker->setTrans(ofVec3f(iU, iV, 0));
+		float vals[2] = {iU, iV};
+		texTweens.setValue(iVertexNum, vals);
 	}
 }
 
@@ -60,8 +161,8 @@ void ofxDynamicPolygonObject::setVertexColor(int iVertexNum, float iR, float iG,
 	vertexColoringEnabled = true;
 
 	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
-		dynamicVerts[iVertexNum]->colorTracker->stopMessages();		
-		dynamicVerts[iVertexNum]->colorTracker->setColor(ofVec4f(iR, iG, iB, iA));	
+		float vals[4] = {iR, iG, iB, iA};
+		colorTweens.setValue(iVertexNum, vals);
 	}
 }
 
@@ -69,26 +170,23 @@ void ofxDynamicPolygonObject::setVertexColor(int iVertexNum, float iR, float iG,
 void ofxDynamicPolygonObject::gotoVertexPos(int iVertexNum, ofVec3f iPos, float iDur, float iDelay, int iInterp)
 {
 	if((iVertexNum >= 0) && (iVertexNum < numVertices)){		
-		dynamicVerts[iVertexNum]->posTracker->stopMessages();		
+		float vals[3] = {iPos.x, iPos.y, iPos.z};
 		if(iDur == -1.0)
-			dynamicVerts[iVertexNum]->posTracker->setTrans(iPos);
+			posTweens.setValue(iVertexNum, vals);
 		else
-			dynamicVerts[iVertexNum]->posTracker->doMessage3f(OF_TRANSLATE, iDelay, iDur, iInterp, iPos.x, iPos.y, iPos.z);
-
+			posTweens.tween(iVertexNum, vals, curTime + iDelay, iDur, iInterp);
 	}
 }
 
 void ofxDynamicPolygonObject::gotoVertexTexCoords(int iVertexNum, float iU, float iV, float iDur, float iDelay, int iInterp)
 {
 	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
-		dynamicVerts[iVertexNum]->texTracker->stopMessages();
+		float vals[2] = {iU, iV};
 		if(iDur == -1.0)
-			dynamicVerts[iVertexNum]->texTracker->setTrans(ofVec3f(iU, iV, 0));
+			texTweens.setValue(iVertexNum, vals);
 		else
-			dynamicVerts[iVertexNum]->texTracker->doMessage3f(OF_TRANSLATE, iDelay, iDur, iInterp, iU, iV, 0);
-
+			texTweens.tween(iVertexNum, vals, curTime + iDelay, iDur, iInterp);
 	}
-
 }
 
 void ofxDynamicPolygonObject::gotoVertexColor(int iVertexNum, float iR, float iG, float iB, float iA, float iDur, float iDelay, int iInterp)
@@ -96,13 +194,15 @@ void ofxDynamicPolygonObject::gotoVertexColor(int iVertexNum, float iR, float iG
 	vertexColoringEnabled = true;
 
 	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
-		dynamicVerts[iVertexNum]->colorTracker->stopMessages();
+		float vals[4] = {iR, iG, iB, iA};
 		if(iDur == -1.0)
-			dynamicVerts[iVertexNum]->colorTracker->setColor(ofVec4f(iR, iG, iB, iA));
+			colorTweens.setValue(iVertexNum, vals);
 		else
-			dynamicVerts[iVertexNum]->texTracker->doMessage3f(OF_SETCOLOR, iDelay, iDur, iInterp, iR, iG, iB);
-			dynamicVerts[iVertexNum]->texTracker->doMessage1f(OF_SETALPHA, iDelay, iDur, iInterp, iA);
-
+			colorTweens.tween(iVertexNum, vals, curTime + iDelay, iDur, iInterp);
 	}
+}
 
+bool ofxDynamicPolygonObject::isAnimatingVertices()
+{
+	return (posTweens.getNumActive() + texTweens.getNumActive() + colorTweens.getNumActive()) > 0;
 }
\ No newline at end of file
@@ -2,7 +2,8 @@
  ofxDynamicPolygonObject
  
  Extension of ofxPolygonObject for conveniently and independently animating the vertex positions, texture coordinates, and colors
- of an arbitrary polygon. It uses dummy ofxObjects, which can be easily animated, that control the parameters.
+ of an arbitrary polygon. Each vertex attribute has its own tween (start, end, delay, duration, interpolation), stored
+ in flat arrays per attribute so all vertices are evaluated together in a few tight loops each frame.
  
  Soso OpenFrameworks Addon
  Copyright (C) 2012 Sosolimited
@@ -27,6 +28,34 @@
 #include "ofxPolygonObject.h"
 
 
+// Structure-of-arrays tween storage for one attribute (position, tex coords, or color) of every vertex.
+// Values are stored component-major: component c of vertex v lives at [c*numVertices + v].
+class ofxVertexTweens
+{
+public:
+	void								setup(int iNumVertices, int iNumComponents, float iInitVal);
+	void								setValue(int iVertexNum, const float *iVals);
+	void								tween(int iVertexNum, const float *iVals, float iStartTime, float iDur, int iInterp);
+	bool								update(float iTime);
+	float								get(int iVertexNum, int iComponent){ return cur[iComponent*numVertices + iVertexNum]; }
+	int									getNumActive(){ return numActive; }
+  
+protected:
+	int									numVertices,
+											numComponents,
+											numActive;
+	bool								isDirty;				//values changed outside of update()
+	vector<float>				cur,
+											start,
+											end;
+	vector<float>				startTimes,			//includes delay
+											durations,
+											progress;				//scratch, per vertex
+	vector<int>					interps;
+	vector<unsigned char>	active;
+};
+
+
 class ofxDynamicPolygonObject : public ofxPolygonObject
 {
 public:
@@ -40,13 +69,12 @@ public:
 	void								gotoVertexPos(int iVertexNum, ofVec3f iPos, float iDur=-1.0, float iDelay=0, int iInterp=OF_LINEAR);
 	void								gotoVertexTexCoords(int iVertexNum, float iU, float iV, float iDur=-1.0, float iDelay=0, int iInterp=OF_LINEAR);
 	void								gotoVertexColor(int iVertexNum, float iR, float iG, float iB, float iA=255, float iDur=-1.0, float iDelay=0, int iInterp=OF_LINEAR);
+	bool								isAnimatingVertices();
   
-public:
-	struct ofxDynamicPolygonVert{	//PEND maybe make one tracker object and just use trans for pos, scale for tex, and color for color
-		ofxObject			*posTracker,
-    *texTracker,
-    *colorTracker;
-	};
-	vector<ofxDynamicPolygonVert *>		dynamicVerts;
+protected:
+	//only changed through the set/goto methods above, which keep the vertex buffer in sync
+	ofxVertexTweens			posTweens,
+											texTweens,
+											colorTweens;
   
 };
\ No newline at end of file
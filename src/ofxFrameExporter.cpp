@@ -0,0 +1,316 @@
+#include "ofxFrameExporter.h"
+#include "ofUtils.h"
+
+ofxFrameExporter::ofxFrameExporter()
+{
+	format = OF_EXPORT_PNG;
+	frameRate = 30;
+	width = 0;
+	height = 0;
+	exporting = false;
+	isBlocking = false;
+	numBuffers = 3;
+	maxQueued = 32;
+	numCaptured = 0;
+	numDropped = 0;
+	numWritten = 0;
+	writeIndex = 0;
+	numPending = 0;
+	isStopping = false;
+	file = NULL;
+}
+
+//The GL context may already be gone, so frames still on the GPU are dropped. Call stop() first to keep them.
+ofxFrameExporter::~ofxFrameExporter()
+{
+	finish(false);
+	for(unsigned int i=0; i < freeFrames.size(); i++)
+		delete freeFrames[i];
+}
+
+//Starts exporting to iPath. Width and height of 0 use the viewport of the first captured frame.
+bool ofxFrameExporter::start(string iPath, int iFormat, int iFrameRate, int iWidth, int iHeight)
+{
+	stop();
+
+	path = ofToDataPath(iPath);
+	format = iFormat;
+	frameRate = iFrameRate;
+	width = iWidth;
+	height = iHeight;
+	numCaptured = 0;
+	numDropped = 0;
+	numWritten = 0;
+
+	if(format != OF_EXPORT_PNG){
+		file = fopen(path.c_str(), "wb");
+		if(!file){
+			ofLogError("ofxFrameExporter") << "couldn't open " << path;
+			return false;
+		}
+	}
+
+	isStopping = false;
+	encoder = std::thread(&ofxFrameExporter::encoderLoop, this);
+	exporting = true;
+
+	return true;
+}
+
+//Reads back the frames still in flight, waits for the encoder to write everything queued and closes the file.
+void ofxFrameExporter::stop()
+{
+	finish(true);
+}
+
+//Without a context, the frames in flight are counted as dropped and the buffers are left to the context.
+void ofxFrameExporter::finish(bool iHasContext)
+{
+	if(!exporting) return;
+
+	if(iHasContext){
+		while(numPending > 0){
+			readBuffer((writeIndex + numBuffers - numPending) % numBuffers);
+			numPending--;
+		}
+		deleteBuffers();
+	}else{
+		std::lock_guard<std::mutex> lock(mutex);
+		numDropped += numPending;
+		numPending = 0;
+		pbos.clear();
+		pboFrames.clear();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isStopping = true;
+	}
+	frameReady.notify_one();
+	encoder.join();
+
+	if(file){
+		fclose(file);
+		file = NULL;
+	}
+	exporting = false;
+
+	if(numDropped > 0)
+		ofLogWarning("ofxFrameExporter") << numDropped << " of " << numCaptured << " frames were dropped exporting " << path;
+}
+
+//Call once per frame, after drawing. Issues the readback for this frame and queues the one from numBuffers-1 frames ago.
+void ofxFrameExporter::capture(int iX, int iY)
+{
+	if(!exporting) return;
+
+	if(pbos.empty()){
+		if((width == 0) || (height == 0)){
+			GLint viewport[4];
+			glGetIntegerv(GL_VIEWPORT, viewport);
+			width = viewport[2];
+			height = viewport[3];
+		}
+		allocateBuffers();
+	}
+
+	GLint alignment;
+	glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[writeIndex]);
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(iX, iY, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+	glPixelStorei(GL_PACK_ALIGNMENT, alignment);
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	pboFrames[writeIndex] = numCaptured++;
+	writeIndex = (writeIndex + 1) % numBuffers;
+	numPending++;
+
+	//the slot written next holds the oldest frame, which should be done by now
+	if(numPending == numBuffers){
+		readBuffer(writeIndex);
+		numPending--;
+	}
+}
+
+//More buffers hide more readback latency, at the cost of as many frames of delay. Takes effect on the next start().
+void ofxFrameExporter::setNumBuffers(int iNum)
+{
+	if(exporting) return;
+	numBuffers = MAX(iNum, 2);
+}
+
+void ofxFrameExporter::setMaxQueuedFrames(int iMax)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	maxQueued = MAX(iMax, 1);
+}
+
+//When the queue is full, capture() waits for the encoder instead of dropping the frame.
+void ofxFrameExporter::enableBlocking(bool iEnable)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	isBlocking = iEnable;
+}
+
+int ofxFrameExporter::getNumWrittenFrames()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return numWritten;
+}
+
+int ofxFrameExporter::getNumDroppedFrames()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return numDropped;
+}
+
+void ofxFrameExporter::allocateBuffers()
+{
+	pbos.resize(numBuffers);
+	pboFrames.resize(numBuffers);
+	glGenBuffers(numBuffers, &pbos[0]);
+	for(int i=0; i < numBuffers; i++){
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[i]);
+		glBufferData(GL_PIXEL_PACK_BUFFER, width*height*4, NULL, GL_STREAM_READ);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	writeIndex = 0;
+	numPending = 0;
+}
+
+void ofxFrameExporter::deleteBuffers()
+{
+	if(pbos.empty()) return;
+
+	glDeleteBuffers((int)pbos.size(), &pbos[0]);
+	pbos.clear();
+	pboFrames.clear();
+}
+
+void ofxFrameExporter::readBuffer(int iIndex)
+{
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[iIndex]);
+	const unsigned char *pixels = (const unsigned char *)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+	if(pixels){
+		enqueue(pboFrames[iIndex], pixels);
+		glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+void ofxFrameExporter::enqueue(int iFrameNum, const unsigned char *iPixels)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if((int)queue.size() >= maxQueued){
+		if(!isBlocking){
+			numDropped++;
+			return;
+		}
+		frameDone.wait(lock, [this]{ return (int)queue.size() < maxQueued; });
+	}
+
+	ofxExportFrame *frame;
+	if(freeFrames.empty())
+		frame = new ofxExportFrame();
+	else{
+		frame = freeFrames.back();
+		freeFrames.pop_back();
+	}
+	frame->frameNum = iFrameNum;
+	frame->pixels.assign(iPixels, iPixels + width*height*4);
+
+	queue.push_back(frame);
+	lock.unlock();
+	frameReady.notify_one();
+}
+
+void ofxFrameExporter::encoderLoop()
+{
+	bool hasHeader = false;
+	while(true){
+		ofxExportFrame *frame;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			frameReady.wait(lock, [this]{ return isStopping || !queue.empty(); });
+			if(queue.empty()) return;
+			frame = queue.front();
+			queue.pop_front();
+		}
+
+		//the size isn't known until the first frame is captured
+		if((format == OF_EXPORT_Y4M) && !hasHeader){
+			fprintf(file, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C444\n", width, height, frameRate);
+			hasHeader = true;
+		}
+		write(frame);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			freeFrames.push_back(frame);
+			numWritten++;
+		}
+		frameDone.notify_one();
+	}
+}
+
+//GL reads bottom row first, so every format walks the rows backwards.
+void ofxFrameExporter::write(ofxExportFrame *iFrame)
+{
+	int rowSize = width*4;
+	const unsigned char *pixels = &iFrame->pixels[0];
+
+	switch(format){
+		case OF_EXPORT_PNG:{
+			image.allocate(width, height, 4);
+			for(int y=0; y < height; y++)
+				memcpy(image.getData() + y*rowSize, pixels + (height - 1 - y)*rowSize, rowSize);
+
+			char num[16];
+			sprintf(num, "_%05d.png", iFrame->frameNum);
+			ofSaveImage(image, path + num);
+			break;
+		}
+		case OF_EXPORT_RAW:{
+			planes.resize(width*3);
+			for(int y=height - 1; y >= 0; y--){
+				const unsigned char *row = pixels + y*rowSize;
+				for(int x=0; x < width; x++){
+					planes[x*3] = row[x*4];
+					planes[x*3 + 1] = row[x*4 + 1];
+					planes[x*3 + 2] = row[x*4 + 2];
+				}
+				fwrite(&planes[0], 1, width*3, file);
+			}
+			break;
+		}
+		case OF_EXPORT_Y4M:{
+			planes.resize(width*height*3);
+			for(int y=0; y < height; y++)
+				writeY4M(pixels + (height - 1 - y)*rowSize, y);
+
+			fputs("FRAME\n", file);
+			fwrite(&planes[0], 1, planes.size(), file);
+			break;
+		}
+	}
+}
+
+//Converts one RGBA row to studio range BT.601 Y, Cb and Cr planes.
+void ofxFrameExporter::writeY4M(const unsigned char *iRow, int iY)
+{
+	int planeSize = width*height;
+	unsigned char *yPlane = &planes[iY*width];
+	unsigned char *uPlane = &planes[planeSize + iY*width];
+	unsigned char *vPlane = &planes[2*planeSize + iY*width];
+
+	for(int x=0; x < width; x++){
+		int r = iRow[x*4];
+		int g = iRow[x*4 + 1];
+		int b = iRow[x*4 + 2];
+		yPlane[x] = (unsigned char)(((66*r + 129*g + 25*b + 128) >> 8) + 16);
+		uPlane[x] = (unsigned char)(((-38*r - 74*g + 112*b + 128) >> 8) + 128);
+		vPlane[x] = (unsigned char)(((112*r - 94*g - 18*b + 128) >> 8) + 128);
+	}
+}
@@ -0,0 +1,115 @@
+/*
+ofxFrameExporter
+
+Saves rendered frames to disk without stalling the render loop. capture() queues a glReadPixels into a ring of
+pixel pack buffers and only maps a buffer a couple of frames later, once the GPU is done with it. The pixels
+are then handed to a background thread, which flips them and writes them out as one of:
+OF_EXPORT_PNG - a numbered PNG per frame, path_00000.png, path_00001.png, ...
+OF_EXPORT_RAW - one file of packed RGB frames, top row first (e.g. ffmpeg -f rawvideo -pix_fmt rgb24).
+OF_EXPORT_Y4M - one YUV4MPEG2 file, 4:4:4 BT.601.
+If the disk falls behind and the queue fills up, frames are dropped and counted, unless blocking is enabled,
+which is what you want when rendering offline with a fixed time step (see ofxClock).
+ofxScene sets one up with startExport().
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF 
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "ofImage.h"
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+enum{
+	OF_EXPORT_PNG,
+	OF_EXPORT_RAW,
+	OF_EXPORT_Y4M
+};
+
+//A frame read back from the GPU, waiting to be written.
+struct ofxExportFrame
+{
+	int								frameNum;
+	vector<unsigned char>			pixels;			//RGBA, bottom row first
+};
+
+class ofxFrameExporter
+{
+public:
+	ofxFrameExporter();
+	~ofxFrameExporter();
+
+	bool							start(string iPath, int iFormat=OF_EXPORT_PNG, int iFrameRate=30, int iWidth=0, int iHeight=0);
+	void							stop();
+	void							capture(int iX=0, int iY=0);
+	bool							isExporting(){ return exporting; }
+
+	void							setNumBuffers(int iNum);
+	void							setMaxQueuedFrames(int iMax);
+	void							enableBlocking(bool iEnable);
+
+	int								getNumCapturedFrames(){ return numCaptured; }
+	int								getNumWrittenFrames();
+	int								getNumDroppedFrames();
+
+protected:
+	void							finish(bool iHasContext);
+	void							allocateBuffers();
+	void							deleteBuffers();
+	void							readBuffer(int iIndex);
+	void							enqueue(int iFrameNum, const unsigned char *iPixels);
+	void							encoderLoop();
+	void							write(ofxExportFrame *iFrame);
+	void							writeY4M(const unsigned char *iRow, int iY);
+
+protected:
+	string							path;
+	int								format;
+	int								frameRate;
+	int								width,
+									height;
+	bool							exporting;
+	bool							isBlocking;
+	int								numBuffers;
+	int								maxQueued;
+	int								numCaptured;
+	int								numDropped;
+	int								numWritten;
+
+	//GL thread
+	vector<GLuint>					pbos;
+	vector<int>						pboFrames;
+	int								writeIndex;
+	int								numPending;
+
+	//shared with the encoder thread
+	std::thread						encoder;
+	std::mutex						mutex;
+	std::condition_variable			frameReady;
+	std::condition_variable			frameDone;
+	deque<ofxExportFrame *>			queue;
+	vector<ofxExportFrame *>		freeFrames;
+	bool							isStopping;
+
+	//encoder thread
+	FILE							*file;
+	vector<unsigned char>			planes;
+	ofPixels						image;
+};
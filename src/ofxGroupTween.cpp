@@ -0,0 +1,225 @@
+#include "ofxGroupTween.h"
+#include "ofxObject.h"
+#include "ofxClock.h"
+#include <cfloat>
+#include <algorithm>
+
+ofxGroupTween::ofxGroupTween(const vector<ofxObject *> &iObjects, int iID, const ofVec4f &iEndVals, int iInterpolation, float iDuration, float iDelay)
+{
+	id = iID;
+	numVals = ofxMessage::getNumVals(iID);
+	interpolation = iInterpolation;
+	startTime = ofxClock::getCurrentTime();
+	startDelay = iDelay;
+	duration = iDuration;
+	baseStartVals.set(OF_RELATIVE_VAL, OF_RELATIVE_VAL, OF_RELATIVE_VAL, OF_RELATIVE_VAL);
+	baseEndVals = iEndVals;
+	autoDelete = true;
+	timeline = NULL;
+
+	objects = iObjects;
+	for(unsigned int i=0; i < objects.size(); i++)
+		objects[i]->groupTweens.push_back(this);
+	int n = size();
+	delays.assign(n, 0);
+	started.assign(n, 0);
+	times.assign(n, 0);
+	eased.assign(n, 0);
+	for(int c=0; c < numVals; c++){
+		startVals[c].assign(n, 0);
+		endVals[c].assign(n, 0);
+		outVals[c].assign(n, 0);
+	}
+}
+
+ofxGroupTween::~ofxGroupTween()
+{
+	if(timeline) timeline->removeGroup(this);
+	for(unsigned int i=0; i < objects.size(); i++)
+		forget(objects[i]);
+}
+
+void ofxGroupTween::setStartVals(const ofVec4f &iStartVals)
+{
+	baseStartVals = iStartVals;
+}
+
+void ofxGroupTween::staggerByIndex(float iStep)
+{
+	for(int i=0; i < size(); i++)
+		delays[i] = i*iStep;
+}
+
+//Uses the members' positions now.
+void ofxGroupTween::staggerByDistance(const ofVec3f &iPoint, float iSecondsPerUnit)
+{
+	for(int i=0; i < size(); i++)
+		delays[i] = objects[i]->getTrans().distance(iPoint)*iSecondsPerUnit;
+}
+
+void ofxGroupTween::staggerRandomly(float iMaxDelay, unsigned int iSeed)
+{
+	//xorshift, so the pattern doesn't depend on (or disturb) ofRandom()
+	unsigned int x = iSeed ? iSeed : 1;
+	for(int i=0; i < size(); i++){
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		delays[i] = (x/4294967296.0)*iMaxDelay;
+	}
+}
+
+float ofxGroupTween::getFinishTime()
+{
+	float maxDelay = 0;
+	for(int i=0; i < size(); i++)
+		maxDelay = MAX(maxDelay, delays[i]);
+
+	return startTime + startDelay + maxDelay + duration;
+}
+
+//Evaluates and writes back every member that has started. Returns true once all of them have finished,
+//or once every member has been deleted.
+bool ofxGroupTween::update(float iTime)
+{
+	int n = size();
+	if(n == 0) return true;
+
+	float t0 = startTime + startDelay;
+	float invDuration = (duration > 0) ? 1.0/duration : FLT_MAX;
+	bool isFinished = true;
+
+	for(int i=0; i < n; i++){
+		float t = iTime - t0 - delays[i];
+		if((t >= 0) && !started[i]) start(i);
+		times[i] = MIN(t*invDuration, 1.0f);
+		if(times[i] < 1.0f) isFinished = false;
+	}
+
+	ofxMessage::interpolateTimes(interpolation, &times[0], &eased[0], n);
+
+	for(int c=0; c < numVals; c++){
+		const float *s = &startVals[c][0];
+		const float *e = &endVals[c][0];
+		float *out = &outVals[c][0];
+		for(int i=0; i < n; i++)
+			out[i] = (1.0f - eased[i])*s[i] + eased[i]*e[i];
+	}
+
+	apply();
+
+	return isFinished;
+}
+
+//Members deleted while the group runs are dropped, keeping the order of the rest.
+void ofxGroupTween::removeObject(ofxObject *iObject)
+{
+	int n = size();
+	int j = 0;
+	for(int i=0; i < n; i++){
+		if(objects[i] == iObject) continue;
+		if(j != i){
+			objects[j] = objects[i];
+			delays[j] = delays[i];
+			started[j] = started[i];
+			for(int c=0; c < numVals; c++){
+				startVals[c][j] = startVals[c][i];
+				endVals[c][j] = endVals[c][i];
+			}
+		}
+		j++;
+	}
+	if(j == n) return;
+	forget(iObject);
+
+	objects.resize(j);
+	delays.resize(j);
+	started.resize(j);
+	times.resize(j);
+	eased.resize(j);
+	for(int c=0; c < numVals; c++){
+		startVals[c].resize(j);
+		endVals[c].resize(j);
+		outVals[c].resize(j);
+	}
+}
+
+//Takes the group off iObject's list of groups.
+void ofxGroupTween::forget(ofxObject *iObject)
+{
+	vector<ofxGroupTween *> &groups = iObject->groupTweens;
+	groups.erase(std::remove(groups.begin(), groups.end(), this), groups.end());
+}
+
+//Resolves relative values against the member, as its delay runs out.
+void ofxGroupTween::start(int iMember)
+{
+	ofxObject *object = objects[iMember];
+	started[iMember] = 1;
+
+	ofVec4f cur;
+	ofVec3f v;
+	switch(id){
+		case OF_TRANSLATE:
+			v = object->getTrans();
+			cur.set(v.x, v.y, v.z, 0);
+			break;
+		case OF_ROTATE:
+			v = object->getRot();
+			cur.set(v.x, v.y, v.z, 0);
+			break;
+		case OF_SCALE:
+		case OF_SCALE3:
+			v = object->getScale();
+			cur.set(v.x, v.y, v.z, 0);
+			break;
+		case OF_SETCOLOR:
+		case OF_SETCOLOR4:
+			cur = object->getColorVec4f();
+			break;
+		case OF_SETALPHA:
+			cur.x = object->getAlpha();
+			break;
+	}
+
+	for(int c=0; c < numVals; c++){
+		startVals[c][iMember] = (baseStartVals[c] == OF_RELATIVE_VAL) ? cur[c] : baseStartVals[c];
+		endVals[c][iMember] = (baseEndVals[c] == OF_RELATIVE_VAL) ? cur[c] : baseEndVals[c];
+	}
+}
+
+//Members still waiting on their delay are left alone.
+void ofxGroupTween::apply()
+{
+	int n = size();
+	if(numVals == 0) return;
+
+	const float *x = &outVals[0][0];
+	const float *y = (numVals > 1) ? &outVals[1][0] : NULL;
+	const float *z = (numVals > 2) ? &outVals[2][0] : NULL;
+	const float *w = (numVals > 3) ? &outVals[3][0] : NULL;
+
+	switch(id){
+		case OF_TRANSLATE:
+			for(int i=0; i < n; i++) if(started[i]) objects[i]->setTrans(x[i], y[i], z[i]);
+			break;
+		case OF_ROTATE:
+			for(int i=0; i < n; i++) if(started[i]) objects[i]->setRot(x[i], y[i], z[i]);
+			break;
+		case OF_SCALE:
+			for(int i=0; i < n; i++) if(started[i]) objects[i]->setScale(x[i]);
+			break;
+		case OF_SCALE3:
+			for(int i=0; i < n; i++) if(started[i]) objects[i]->setScale(x[i], y[i], z[i]);
+			break;
+		case OF_SETCOLOR:
+			for(int i=0; i < n; i++) if(started[i]) objects[i]->setColor(x[i], y[i], z[i]);
+			break;
+		case OF_SETCOLOR4:
+			for(int i=0; i < n; i++) if(started[i]) objects[i]->setColor(x[i], y[i], z[i], w[i]);
+			break;
+		case OF_SETALPHA:
+			for(int i=0; i < n; i++) if(started[i]) objects[i]->setAlpha(x[i]);
+			break;
+	}
+}
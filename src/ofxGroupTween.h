@@ -0,0 +1,80 @@
+/*
+ofxGroupTween
+
+Tweens one property of many objects at once, each starting after its own delay, like a wave across a grid.
+The whole group is a single entry on the timeline, with its members' delays and values in flat arrays,
+so it costs no ofxMessage per member. Set the delays with one of the stagger methods:
+staggerByIndex() - member i waits i*step.
+staggerByDistance() - members wait in proportion to their distance from a point.
+staggerRandomly() - random delays from a seed, so the same seed gives the same pattern.
+Start values of OF_RELATIVE_VAL are picked up from each member when its own delay runs out.
+Add it with ofxScene::getTimeline()->addGroup(). Groups play once, and are deleted when they finish unless
+autoDelete is turned off.
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF 
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "ofxMessage.h"
+
+class ofxObject;
+
+class ofxGroupTween
+{
+public:
+	ofxGroupTween(const vector<ofxObject *> &iObjects, int iID, const ofVec4f &iEndVals, int iInterpolation, float iDuration, float iDelay=0);
+	~ofxGroupTween();
+
+	void							setStartVals(const ofVec4f &iStartVals);
+	void							staggerByIndex(float iStep);
+	void							staggerByDistance(const ofVec3f &iPoint, float iSecondsPerUnit);
+	void							staggerRandomly(float iMaxDelay, unsigned int iSeed);
+	float							getFinishTime();
+
+	bool							update(float iTime);
+	void							removeObject(ofxObject *iObject);
+	int								size(){ return (int)objects.size(); }
+
+protected:
+	void							start(int iMember);
+	void							forget(ofxObject *iObject);
+	void							apply();
+
+public:
+	int								id;
+	int								numVals;
+	int								interpolation;
+	float							startTime,
+									startDelay,
+									duration;
+	ofVec4f							baseStartVals,
+									baseEndVals;
+	bool							autoDelete;
+	ofxMessageTimeline				*timeline;		//set while the group is on a timeline
+
+protected:
+	vector<ofxObject *>				objects;
+	vector<float>					delays;
+	vector<unsigned char>			started;
+	vector<float>					times;
+	vector<float>					eased;
+	vector<float>					startVals[4];
+	vector<float>					endVals[4];
+	vector<float>					outVals[4];
+};
@@ -3,31 +3,104 @@
 ofxLineStripObject::ofxLineStripObject(int iNumVerts)
 {
 	lineWidth = 1.0;
-	for(int i=0; i < iNumVerts; i++){
-		addVertex(0,0,0);
-  }
-  
   isVertexColoringEnabled = false;
+  
+  vbo = 0;
+  vboCapacity = 0;
+  posDirtyFrom = colorDirtyFrom = 0;
+  posDirtyTo = colorDirtyTo = -1;
+  uploadedAlpha = -1;
+  
+  setNumVertices(iNumVerts);
 }
 
 ofxLineStripObject::~ofxLineStripObject(){
-  for (auto vertex : vertices){
-    delete vertex;
-  }
-  vertices.clear();
+  if(vbo) glDeleteBuffers(1, &vbo);
 }
 
 void ofxLineStripObject::render()
 {
+  int numVerts = positions.size();
+  if(numVerts == 0) return;
+  
+  //vertex colors are multiplied by the object's alpha on upload, so a fade re-sends them
+  if(isVertexColoringEnabled && (drawMaterial->color.a != uploadedAlpha))
+    markColorsDirty(0, numVerts-1);
+  
+  uploadVertexBuffer();
+  
 	glLineWidth(lineWidth);
-	glBegin(GL_LINE_STRIP);
-	for(int i=0; i < vertices.size(); i++){
-		if(isVertexColoringEnabled)
-      glColor4f(vertices[i]->color.r/255.0f, vertices[i]->color.g/255.0f, vertices[i]->color.b/255.0f, drawMaterial->color.a/255.0f * vertices[i]->color.a/255.0f);
+  
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(3, GL_FLOAT, sizeof(ofVec3f), 0);
+  if(isVertexColoringEnabled){
+    glEnableClientState(GL_COLOR_ARRAY);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(ofColor), (GLvoid *)(vboCapacity*sizeof(ofVec3f)));
+  }
+  
+  glDrawArrays(GL_LINE_STRIP, 0, numVerts);
+  
+  if(isVertexColoringEnabled)
+    glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+//Sends the dirty ranges to the vertex buffer, reallocating it (and sending everything) if the strip outgrew it.
+//The buffer holds all positions followed by all colors.
+void ofxLineStripObject::uploadVertexBuffer()
+{
+  int numVerts = positions.size();
+  
+  if(!vbo) glGenBuffers(1, &vbo);
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  
+  if(numVerts > vboCapacity){
+    vboCapacity = MAX(numVerts, 2*vboCapacity);
+    glBufferData(GL_ARRAY_BUFFER, vboCapacity*(sizeof(ofVec3f) + sizeof(ofColor)), NULL, GL_DYNAMIC_DRAW);
+    markPositionsDirty(0, numVerts-1);
+    markColorsDirty(0, numVerts-1);
+  }
+  
+  posDirtyTo = MIN(posDirtyTo, numVerts-1);
+  if(posDirtyTo >= posDirtyFrom){
+    glBufferSubData(GL_ARRAY_BUFFER, posDirtyFrom*sizeof(ofVec3f), (posDirtyTo - posDirtyFrom + 1)*sizeof(ofVec3f), &positions[posDirtyFrom]);
+    posDirtyFrom = numVerts;
+    posDirtyTo = -1;
+  }
+  
+  //colors stay dirty while vertex coloring is off
+  colorDirtyTo = MIN(colorDirtyTo, numVerts-1);
+  if(isVertexColoringEnabled && (colorDirtyTo >= colorDirtyFrom)){
+    int num = colorDirtyTo - colorDirtyFrom + 1;
+    float alpha = drawMaterial->color.a/255.0f;
     
-    glVertex3f(vertices[i]->position.x, vertices[i]->position.y, vertices[i]->position.z);
-	}
-	glEnd();
+    colorScratch.resize(num);
+    for(int i=0; i < num; i++){
+      colorScratch[i] = colors[colorDirtyFrom + i];
+      colorScratch[i].a = colors[colorDirtyFrom + i].a * alpha;
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, vboCapacity*sizeof(ofVec3f) + colorDirtyFrom*sizeof(ofColor), num*sizeof(ofColor), &colorScratch[0]);
+    
+    uploadedAlpha = drawMaterial->color.a;
+    colorDirtyFrom = numVerts;
+    colorDirtyTo = -1;
+  }
+  
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ofxLineStripObject::markPositionsDirty(int iFrom, int iTo)
+{
+  posDirtyFrom = MIN(posDirtyFrom, iFrom);
+  posDirtyTo = MAX(posDirtyTo, iTo);
+}
+
+void ofxLineStripObject::markColorsDirty(int iFrom, int iTo)
+{
+  colorDirtyFrom = MIN(colorDirtyFrom, iFrom);
+  colorDirtyTo = MAX(colorDirtyTo, iTo);
 }
 
 
@@ -38,32 +111,100 @@ void ofxLineStripObject::setLineWidth(float iWidth)
 
 void ofxLineStripObject::setVertexPos(int iVertNum, float iX, float iY, float iZ)
 {
-	if(ofInRange(iVertNum, 0, vertices.size()-1)){
-		vertices[iVertNum]->position.set(iX, iY, iZ);
+	if((iVertNum >= 0) && (iVertNum < (int)positions.size())){
+		positions[iVertNum].set(iX, iY, iZ);
+    markPositionsDirty(iVertNum, iVertNum);
 	}
 }
 
 void ofxLineStripObject::setVertexColor(int iVertNum, float iR, float iG, float iB, float iA)
 {
-	if(ofInRange(iVertNum, 0, vertices.size()-1)){
-		vertices[iVertNum]->color.set(iR, iG, iB, iA);
+	if((iVertNum >= 0) && (iVertNum < (int)colors.size())){
+		colors[iVertNum].set(iR, iG, iB, iA);
+    markColorsDirty(iVertNum, iVertNum);
 	}
 }
 
 void ofxLineStripObject::addVertex(float iX, float iY, float iZ)
 {
-  ofxLineStripVertex *vert = new ofxLineStripVertex();
-  vert->position.set(iX, iY, iZ);
-  vert->color.set(255, 255, 255, 255);
-	vertices.push_back(vert);
+  addVertex(iX, iY, iZ, ofColor(255, 255, 255, 255));
 }
 
 void ofxLineStripObject::addVertex(float iX, float iY, float iZ, ofColor iColor)
 {
-  ofxLineStripVertex *vert = new ofxLineStripVertex();
-  vert->position.set(iX, iY, iZ);
-  vert->color = iColor;
-	vertices.push_back(vert);
+  positions.push_back(ofVec3f(iX, iY, iZ));
+  colors.push_back(iColor);
+  
+  int last = positions.size() - 1;
+  markPositionsDirty(last, last);
+  markColorsDirty(last, last);
+}
+
+void ofxLineStripObject::setVertices(const ofVec3f *iPositions, int iNumVerts, int iFirstVert)
+{
+  if((iNumVerts <= 0) || (iFirstVert < 0)) return;
+  
+  if(iFirstVert + iNumVerts > (int)positions.size())
+    setNumVertices(iFirstVert + iNumVerts);
+  
+  memcpy(&positions[iFirstVert], iPositions, iNumVerts*sizeof(ofVec3f));
+  markPositionsDirty(iFirstVert, iFirstVert + iNumVerts - 1);
+}
+
+//Replaces all positions, resizing the strip to match.
+void ofxLineStripObject::setVertices(const vector<ofVec3f> &iPositions)
+{
+  setNumVertices(iPositions.size());
+  if(iPositions.size()) setVertices(&iPositions[0], iPositions.size());
+}
+
+void ofxLineStripObject::setVertexColors(const ofColor *iColors, int iNumVerts, int iFirstVert)
+{
+  if((iNumVerts <= 0) || (iFirstVert < 0)) return;
+  
+  if(iFirstVert + iNumVerts > (int)colors.size())
+    setNumVertices(iFirstVert + iNumVerts);
+  
+  memcpy(&colors[iFirstVert], iColors, iNumVerts*sizeof(ofColor));
+  markColorsDirty(iFirstVert, iFirstVert + iNumVerts - 1);
+}
+
+//Replaces all colors, resizing the strip to match.
+void ofxLineStripObject::setVertexColors(const vector<ofColor> &iColors)
+{
+  setNumVertices(iColors.size());
+  if(iColors.size()) setVertexColors(&iColors[0], iColors.size());
+}
+
+//New vertices start at the origin, colored white.
+void ofxLineStripObject::setNumVertices(int iNumVerts)
+{
+  int prevNum = positions.size();
+  
+  positions.resize(iNumVerts, ofVec3f(0, 0, 0));
+  colors.resize(iNumVerts, ofColor(255, 255, 255, 255));
+  
+  if(iNumVerts > prevNum){
+    markPositionsDirty(prevNum, iNumVerts-1);
+    markColorsDirty(prevNum, iNumVerts-1);
+  }
+}
+
+int ofxLineStripObject::getNumVertices()
+{
+  return positions.size();
+}
+
+ofVec3f ofxLineStripObject::getVertexPos(int iVertNum)
+{
+  if((iVertNum >= 0) && (iVertNum < (int)positions.size())) return positions[iVertNum];
+  return ofVec3f();
+}
+
+ofColor ofxLineStripObject::getVertexColor(int iVertNum)
+{
+  if((iVertNum >= 0) && (iVertNum < (int)colors.size())) return colors[iVertNum];
+  return ofColor();
 }
 
 void ofxLineStripObject::enableVertexColoring(bool iEnable)
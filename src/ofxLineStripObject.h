@@ -2,6 +2,9 @@
  ofxLineStripObject
  
  Simple ofxObject for drawing and manipulating line strips.
+ Positions and colors are stored in contiguous arrays and streamed to a vertex buffer. Only the range
+ of vertices touched since the last frame gets re-uploaded, so use setVertices() / setVertexColors()
+ to update long strips in one copy.
  
  Soso OpenFrameworks Addon
  Copyright (C) 2012 Sosolimited
@@ -34,24 +37,43 @@ public:
 	void								render();
 	
   void								addVertex(float iX, float iY, float iZ);
-  void                                addVertex(float iX, float iY, float iZ, ofColor iColor);
+  void                addVertex(float iX, float iY, float iZ, ofColor iColor);
   
 	void								setLineWidth(float iWeight);
 	void								setVertexPos(int iVertNum, float iX, float iY, float iZ);
 	void								setVertexColor(int iVertNum, float iR, float iG, float iB, float iA);
   void                enableVertexColoring(bool iEnable);
   
-public:
+  // bulk updates, copying iNumVerts entries starting at vertex iFirstVert (the strip grows if needed)
+  void                setVertices(const ofVec3f *iPositions, int iNumVerts, int iFirstVert=0);
+  void                setVertices(const vector<ofVec3f> &iPositions);
+  void                setVertexColors(const ofColor *iColors, int iNumVerts, int iFirstVert=0);
+  void                setVertexColors(const vector<ofColor> &iColors);
+  
+  void                setNumVertices(int iNumVerts);
+  int                 getNumVertices();
+  ofVec3f             getVertexPos(int iVertNum);
+  ofColor             getVertexColor(int iVertNum);
   
-  struct ofxLineStripVertex{
-    ofVec3f position;
-    //ofVec4f color;
-    ofColor color;
-  };
-	vector<ofxLineStripVertex *>		vertices;
+protected:
+  void                markPositionsDirty(int iFrom, int iTo);
+  void                markColorsDirty(int iFrom, int iTo);
+  void                uploadVertexBuffer();
   
+public:
 	float								lineWidth;
   bool                isVertexColoringEnabled;
   
+protected:
+  vector<ofVec3f>     positions;        //only changed through the setters above, which track the dirty ranges
+  vector<ofColor>     colors;
+  GLuint              vbo;
+  int                 vboCapacity;      //in vertices
+  int                 posDirtyFrom,     //range of vertices changed since the last upload
+                      posDirtyTo,
+                      colorDirtyFrom,
+                      colorDirtyTo;
+  float               uploadedAlpha;    //object alpha the uploaded colors were scaled by
+  vector<ofColor>     colorScratch;
   
 };
\ No newline at end of file
@@ -0,0 +1,762 @@
+#include "ofxLottieImporter.h"
+#include "ofUtils.h"
+#include "ofColor.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+
+enum
+{
+	JSON_NULL,
+	JSON_BOOL,
+	JSON_NUMBER,
+	JSON_STRING,
+	JSON_ARRAY,
+	JSON_OBJECT
+};
+
+static const int MAX_JSON_DEPTH = 256;
+
+static void skipSpace(const string &iJson, size_t &ioPos)
+{
+	while((ioPos < iJson.size()) && isspace((unsigned char)iJson[ioPos]))
+		ioPos++;
+}
+
+static void appendUTF8(string &ioText, unsigned int iCode)
+{
+	if(iCode < 0x80)
+		ioText += (char)iCode;
+	else if(iCode < 0x800){
+		ioText += (char)(0xC0 | (iCode >> 6));
+		ioText += (char)(0x80 | (iCode & 0x3F));
+	}
+	else if(iCode < 0x10000){
+		ioText += (char)(0xE0 | (iCode >> 12));
+		ioText += (char)(0x80 | ((iCode >> 6) & 0x3F));
+		ioText += (char)(0x80 | (iCode & 0x3F));
+	}
+	else{
+		ioText += (char)(0xF0 | (iCode >> 18));
+		ioText += (char)(0x80 | ((iCode >> 12) & 0x3F));
+		ioText += (char)(0x80 | ((iCode >> 6) & 0x3F));
+		ioText += (char)(0x80 | (iCode & 0x3F));
+	}
+}
+
+static float bezier1D(float iP1, float iP2, float iS)
+{
+	float r = 1.0f - iS;
+	return 3*r*r*iS*iP1 + 3*r*iS*iS*iP2 + iS*iS*iS;
+}
+
+//Handle d of a per-dimension (or shared) ease, or iDefault if there is none.
+static float getHandle(const vector<float> &iHandles, int iDim, float iDefault)
+{
+	if(iHandles.empty()) return iDefault;
+	return iHandles[MIN(iDim, (int)iHandles.size() - 1)];
+}
+
+ofxLottieImporter::ofxLottieImporter()
+{
+	isCentered = true;
+	oversampling = 2;
+	width = 0;
+	height = 0;
+	frameRate = 30;
+	inPoint = 0;
+	outPoint = 0;
+}
+
+bool ofxLottieImporter::load(string iPath)
+{
+	string path = ofToDataPath(iPath);
+	ifstream file(path.c_str(), ios::binary);
+	if(!file){
+		ofLogError("ofxLottieImporter") << "couldn't open " << path;
+		return false;
+	}
+	stringstream json;
+	json << file.rdbuf();
+
+	return parse(json.str());
+}
+
+//Parses a Lottie composition and bakes its layers.
+bool ofxLottieImporter::parse(const string &iJson)
+{
+	nodes.clear();
+	tracks.clear();
+	segments.clear();
+	values.clear();
+	names.assign(1, '\0');
+
+	size_t pos = 0;
+	int root = parseValue(iJson, pos);
+	skipSpace(iJson, pos);
+	if((root < 0) || (pos != iJson.size()) || (nodes[root].type != JSON_OBJECT)){
+		ofLogError("ofxLottieImporter") << "invalid JSON near character " << pos;
+		nodes.clear();
+		return false;
+	}
+
+	width = getNumber(root, "w", 0);
+	height = getNumber(root, "h", 0);
+	frameRate = getNumber(root, "fr", 30);
+	inPoint = getNumber(root, "ip", 0);
+	outPoint = getNumber(root, "op", inPoint);
+	if(frameRate <= 0){
+		ofLogError("ofxLottieImporter") << "invalid frame rate " << frameRate;
+		return false;
+	}
+
+	int layers = getMember(root, "layers");
+	if(layers >= 0){
+		for(int l=nodes[layers].firstChild; l >= 0; l=nodes[l].nextSibling)
+			bakeLayer(l);
+	}
+
+	if(tracks.empty())
+		ofLogWarning("ofxLottieImporter") << "no layers to import";
+	nodes.clear();
+
+	return true;
+}
+
+bool ofxLottieImporter::save(string iPath)
+{
+	ofxBakedTracks baked;
+	return getTracks(&baked) && baked.save(iPath);
+}
+
+//Hands the baked tracks to oTracks.
+bool ofxLottieImporter::getTracks(ofxBakedTracks *oTracks)
+{
+	ofxBakedTracksHeader header;
+	memcpy(header.magic, "SOTK", 4);
+	header.version = OF_BAKED_TRACKS_VERSION;
+	header.numTracks = (uint32_t)tracks.size();
+	header.numSegments = (uint32_t)segments.size();
+	header.numValues = (uint32_t)values.size();
+	header.namesSize = (uint32_t)names.size();
+	header.duration = MAX(outPoint - inPoint, 0)/frameRate;
+	header.frameRate = frameRate;
+
+	vector<char> data(sizeof(header) + tracks.size()*sizeof(ofxBakedTrack) + segments.size()*sizeof(ofxBakedSegment) +
+					  values.size()*sizeof(float) + names.size());
+	char *p = &data[0];
+	memcpy(p, &header, sizeof(header));
+	p += sizeof(header);
+	if(!tracks.empty()) memcpy(p, &tracks[0], tracks.size()*sizeof(ofxBakedTrack));
+	p += tracks.size()*sizeof(ofxBakedTrack);
+	if(!segments.empty()) memcpy(p, &segments[0], segments.size()*sizeof(ofxBakedSegment));
+	p += segments.size()*sizeof(ofxBakedSegment);
+	if(!values.empty()) memcpy(p, &values[0], values.size()*sizeof(float));
+	p += values.size()*sizeof(float);
+	memcpy(p, names.data(), names.size());
+
+	return oTracks->setData(data);
+}
+
+
+
+
+//JSON ______________________________________________________________________________
+
+//Parses the value at ioPos and returns its node, or -1 on a syntax error.
+int ofxLottieImporter::parseValue(const string &iJson, size_t &ioPos, int iDepth)
+{
+	skipSpace(iJson, ioPos);
+	if(ioPos >= iJson.size()) return -1;
+
+	char c = iJson[ioPos];
+	if((c == '{') || (c == '[')){
+		if(iDepth >= MAX_JSON_DEPTH) return -1;
+		bool isObject = (c == '{');
+		int node = addNode(isObject ? JSON_OBJECT : JSON_ARRAY);
+		ioPos++;
+		skipSpace(iJson, ioPos);
+		if((ioPos < iJson.size()) && (iJson[ioPos] == (isObject ? '}' : ']'))){
+			ioPos++;
+			return node;
+		}
+
+		while(true){
+			string key;
+			if(isObject){
+				skipSpace(iJson, ioPos);
+				if(!parseString(iJson, ioPos, key)) break;
+				skipSpace(iJson, ioPos);
+				if((ioPos >= iJson.size()) || (iJson[ioPos] != ':')) break;
+				ioPos++;
+			}
+			int child = parseValue(iJson, ioPos, iDepth + 1);
+			if(child < 0) break;
+			nodes[child].key = key;
+			addChild(node, child);
+
+			skipSpace(iJson, ioPos);
+			if(ioPos >= iJson.size()) break;
+			if(iJson[ioPos] == ','){
+				ioPos++;
+				continue;
+			}
+			if(iJson[ioPos] == (isObject ? '}' : ']')){
+				ioPos++;
+				return node;
+			}
+			break;
+		}
+		return -1;
+	}
+
+	if(c == '"'){
+		int node = addNode(JSON_STRING);
+		string text;
+		if(!parseString(iJson, ioPos, text)) return -1;
+		nodes[node].text = text;
+		return node;
+	}
+
+	if(iJson.compare(ioPos, 4, "true") == 0){
+		ioPos += 4;
+		int node = addNode(JSON_BOOL);
+		nodes[node].number = 1;
+		return node;
+	}
+	if(iJson.compare(ioPos, 5, "false") == 0){
+		ioPos += 5;
+		return addNode(JSON_BOOL);
+	}
+	if(iJson.compare(ioPos, 4, "null") == 0){
+		ioPos += 4;
+		return addNode(JSON_NULL);
+	}
+
+	const char *start = iJson.c_str() + ioPos;
+	char *end;
+	double number = strtod(start, &end);
+	if(end == start) return -1;
+	ioPos += end - start;
+	int node = addNode(JSON_NUMBER);
+	nodes[node].number = number;
+
+	return node;
+}
+
+bool ofxLottieImporter::parseString(const string &iJson, size_t &ioPos, string &oText)
+{
+	if((ioPos >= iJson.size()) || (iJson[ioPos] != '"')) return false;
+	ioPos++;
+
+	while(ioPos < iJson.size()){
+		char c = iJson[ioPos++];
+		if(c == '"') return true;
+		if(c != '\\'){
+			oText += c;
+			continue;
+		}
+		if(ioPos >= iJson.size()) return false;
+
+		c = iJson[ioPos++];
+		switch(c){
+			case 'b': oText += '\b'; break;
+			case 'f': oText += '\f'; break;
+			case 'n': oText += '\n'; break;
+			case 'r': oText += '\r'; break;
+			case 't': oText += '\t'; break;
+			case 'u':{
+				if(ioPos + 4 > iJson.size()) return false;
+				unsigned int code = (unsigned int)strtoul(iJson.substr(ioPos, 4).c_str(), NULL, 16);
+				ioPos += 4;
+				//surrogate pair
+				if((code >= 0xD800) && (code < 0xDC00) && (ioPos + 6 <= iJson.size()) && (iJson.compare(ioPos, 2, "\\u") == 0)){
+					unsigned int low = (unsigned int)strtoul(iJson.substr(ioPos + 2, 4).c_str(), NULL, 16);
+					if((low >= 0xDC00) && (low < 0xE000)){
+						code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+						ioPos += 6;
+					}
+				}
+				appendUTF8(oText, code);
+				break;
+			}
+			default: oText += c; break;
+		}
+	}
+
+	return false;
+}
+
+int ofxLottieImporter::addNode(int iType)
+{
+	ofxLottieNode node;
+	node.type = iType;
+	node.number = 0;
+	node.firstChild = -1;
+	node.lastChild = -1;
+	node.nextSibling = -1;
+	nodes.push_back(node);
+
+	return (int)nodes.size() - 1;
+}
+
+void ofxLottieImporter::addChild(int iParent, int iChild)
+{
+	if(nodes[iParent].lastChild >= 0)
+		nodes[nodes[iParent].lastChild].nextSibling = iChild;
+	else
+		nodes[iParent].firstChild = iChild;
+	nodes[iParent].lastChild = iChild;
+}
+
+int ofxLottieImporter::getMember(int iNode, const char *iKey)
+{
+	if((iNode < 0) || (nodes[iNode].type != JSON_OBJECT)) return -1;
+	for(int c=nodes[iNode].firstChild; c >= 0; c=nodes[c].nextSibling){
+		if(nodes[c].key == iKey) return c;
+	}
+
+	return -1;
+}
+
+double ofxLottieImporter::getNumber(int iNode, const char *iKey, double iDefault)
+{
+	int member = getMember(iNode, iKey);
+	if(member < 0) return iDefault;
+	if((nodes[member].type == JSON_NUMBER) || (nodes[member].type == JSON_BOOL))
+		return nodes[member].number;
+	//some exporters wrap numbers in arrays
+	if((nodes[member].type == JSON_ARRAY) && (nodes[member].firstChild >= 0) && (nodes[nodes[member].firstChild].type == JSON_NUMBER))
+		return nodes[nodes[member].firstChild].number;
+
+	return iDefault;
+}
+
+//Reads a number or an array of numbers.
+void ofxLottieImporter::getNumbers(int iNode, vector<float> &oVals)
+{
+	oVals.clear();
+	if(iNode < 0) return;
+	if(nodes[iNode].type == JSON_NUMBER)
+		oVals.push_back(nodes[iNode].number);
+	else if(nodes[iNode].type == JSON_ARRAY){
+		for(int c=nodes[iNode].firstChild; c >= 0; c=nodes[c].nextSibling){
+			if(nodes[c].type == JSON_NUMBER) oVals.push_back(nodes[c].number);
+		}
+	}
+}
+
+
+
+
+//Keyframes ______________________________________________________________________________
+
+//Reads the keys of an animated property, or a single key for a static one.
+bool ofxLottieImporter::readKeys(int iProperty, vector<ofxLottieKey> &oKeys)
+{
+	oKeys.clear();
+	int k = getMember(iProperty, "k");
+	if(k < 0) return false;
+
+	int first = nodes[k].firstChild;
+	bool isAnimated = (nodes[k].type == JSON_ARRAY) && (first >= 0) && (nodes[first].type == JSON_OBJECT);
+	if(!isAnimated){
+		ofxLottieKey key;
+		key.time = 0;
+		key.isHold = true;
+		getNumbers(k, key.startVals);
+		if(key.startVals.empty()) return false;
+		oKeys.push_back(key);
+		return true;
+	}
+
+	for(int c=first; c >= 0; c=nodes[c].nextSibling){
+		ofxLottieKey key;
+		key.time = getNumber(c, "t", 0);
+		key.isHold = (getNumber(c, "h", 0) != 0);
+		getNumbers(getMember(c, "s"), key.startVals);
+		getNumbers(getMember(c, "e"), key.endVals);
+		int out = getMember(c, "o");
+		int in = getMember(c, "i");
+		getNumbers(getMember(out, "x"), key.outX);
+		getNumbers(getMember(out, "y"), key.outY);
+		getNumbers(getMember(in, "x"), key.inX);
+		getNumbers(getMember(in, "y"), key.inY);
+		getNumbers(getMember(c, "to"), key.outTangent);
+		getNumbers(getMember(c, "ti"), key.inTangent);
+
+		//ignore straight motion paths
+		bool isStraight = true;
+		for(unsigned int i=0; i < key.outTangent.size(); i++)
+			if(key.outTangent[i] != 0) isStraight = false;
+		for(unsigned int i=0; i < key.inTangent.size(); i++)
+			if(key.inTangent[i] != 0) isStraight = false;
+		if(isStraight){
+			key.outTangent.clear();
+			key.inTangent.clear();
+		}
+
+		//old exports end with a key that has no values
+		if(key.startVals.empty() && !oKeys.empty()){
+			const ofxLottieKey &prev = oKeys.back();
+			key.startVals = prev.endVals.empty() ? prev.startVals : prev.endVals;
+		}
+		if(!key.startVals.empty()) oKeys.push_back(key);
+	}
+
+	return !oKeys.empty();
+}
+
+//Sets oVals to the value between key iKey and the next one, at iU in [0, 1].
+void ofxLottieImporter::evaluateKey(const vector<ofxLottieKey> &iKeys, int iKey, float iU, vector<float> &oVals)
+{
+	const ofxLottieKey &key = iKeys[iKey];
+	const vector<float> &v0 = key.startVals;
+	const vector<float> &v1 = key.endVals.empty() ? iKeys[iKey + 1].startVals : key.endVals;
+	oVals = v0;
+	if(key.isHold) return;
+
+	int n = (int)MIN(v0.size(), v1.size());
+	bool isCurved = (key.outTangent.size() >= (unsigned int)n) && (key.inTangent.size() >= (unsigned int)n);
+	for(int d=0; d < n; d++){
+		//motion paths share the first dimension's ease
+		int e = isCurved ? 0 : d;
+		float y = ease(getHandle(key.outX, e, 0), getHandle(key.outY, e, 0), getHandle(key.inX, e, 1.0), getHandle(key.inY, e, 1.0), iU);
+		if(isCurved){
+			float r = 1.0f - y;
+			oVals[d] = r*r*r*v0[d] + 3*r*r*y*(v0[d] + key.outTangent[d]) + 3*r*y*y*(v1[d] + key.inTangent[d]) + y*y*y*v1[d];
+		}
+		else
+			oVals[d] = v0[d] + (v1[d] - v0[d])*y;
+	}
+}
+
+void ofxLottieImporter::evaluateKeys(const vector<ofxLottieKey> &iKeys, float iFrame, vector<float> &oVals)
+{
+	int i = 0;
+	while((i + 1 < (int)iKeys.size()) && (iKeys[i + 1].time <= iFrame))
+		i++;
+
+	if((i + 1 >= (int)iKeys.size()) || (iFrame <= iKeys[i].time)){
+		oVals = iKeys[i].startVals;
+		return;
+	}
+
+	float u = (iFrame - iKeys[i].time)/(iKeys[i + 1].time - iKeys[i].time);
+	evaluateKey(iKeys, i, u, oVals);
+}
+
+//After Effects' ease: a cubic bezier from (0, 0) to (1, 1) with handles (iOutX, iOutY) and (iInX, iInY),
+//solved for x = iU.
+float ofxLottieImporter::ease(float iOutX, float iOutY, float iInX, float iInY, float iU)
+{
+	if((iOutX == iOutY) && (iInX == iInY)) return iU;
+
+	iOutX = MIN(MAX(iOutX, 0), 1.0);
+	iInX = MIN(MAX(iInX, 0), 1.0);
+
+	//newton's method, falling back on bisection
+	float s = iU;
+	for(int i=0; i < 8; i++){
+		float x = bezier1D(iOutX, iInX, s) - iU;
+		float r = 1.0f - s;
+		float dx = 3*r*r*iOutX + 6*r*s*(iInX - iOutX) + 3*s*s*(1.0f - iInX);
+		if(fabsf(x) < 1e-6f) return bezier1D(iOutY, iInY, s);
+		if(fabsf(dx) < 1e-6f) break;
+		s -= x/dx;
+		if((s < 0) || (s > 1.0)) break;
+	}
+
+	float lo = 0, hi = 1.0;
+	s = iU;
+	for(int i=0; i < 32; i++){
+		float x = bezier1D(iOutX, iInX, s);
+		if(fabsf(x - iU) < 1e-6f) break;
+		if(x < iU) lo = s;
+		else hi = s;
+		s = (lo + hi)/2;
+	}
+
+	return bezier1D(iOutY, iInY, s);
+}
+
+
+
+
+//Baking ______________________________________________________________________________
+
+void ofxLottieImporter::bakeLayer(int iLayer)
+{
+	if(getNumber(iLayer, "hd", 0) != 0) return;
+	int transform = getMember(iLayer, "ks");
+	if(transform < 0) return;
+
+	string name;
+	int nm = getMember(iLayer, "nm");
+	if(nm >= 0) name = nodes[nm].text;
+	if(name.empty()) name = "Layer " + ofToString((int)getNumber(iLayer, "ind", 0));
+
+	//keys are in layer time, which starts at st
+	float timeOffset = getNumber(iLayer, "st", 0);
+	bool isRoot = (getMember(iLayer, "parent") < 0);
+	float flip = isCentered ? -1.0 : 1.0;
+
+	ofxLottieChannelMap position = {OF_TRANSLATE, 3, {0, 1, 2, -1}, {1.0, flip, flip, 1.0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
+	if(isCentered && isRoot){
+		position.offset[0] = -width/2;
+		position.offset[1] = height/2;
+	}
+	int p = getMember(transform, "p");
+	if(getNumber(p, "s", 0) != 0)
+		bakeSplitPosition(name, p, position, timeOffset);
+	else
+		bakeProperty(name, p, position, timeOffset);
+
+	ofxLottieChannelMap rotation = {OF_ROTATE, 3, {-1, -1, 0, -1}, {1.0, 1.0, flip, 1.0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
+	int r = getMember(transform, "r");
+	bakeProperty(name, (r >= 0) ? r : getMember(transform, "rz"), rotation, timeOffset);
+
+	ofxLottieChannelMap scale = {OF_SCALE3, 3, {0, 1, 2, -1}, {0.01, 0.01, 0.01, 1.0}, {0, 0, 0, 0}, {1.0, 1.0, 1.0, 0}};
+	bakeProperty(name, getMember(transform, "s"), scale, timeOffset);
+
+	ofxLottieChannelMap opacity = {OF_SETALPHA, 1, {0, -1, -1, -1}, {2.55, 1.0, 1.0, 1.0}, {0, 0, 0, 0}, {255.0, 0, 0, 0}};
+	bakeProperty(name, getMember(transform, "o"), opacity, timeOffset);
+
+	bakeColor(name, iLayer, timeOffset);
+
+	//in and out points, in composition time
+	float layerIn = getNumber(iLayer, "ip", inPoint);
+	float layerOut = getNumber(iLayer, "op", outPoint);
+	ofxLottieChannelMap shown = {OF_SHOW, 1, {0, -1, -1, -1}, {1.0, 1.0, 1.0, 1.0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
+	vector<float> on(1, 1.0), off(1, 0);
+	beginTrack(name, shown);
+	if(layerIn > inPoint){
+		addSegment(OF_BAKED_HOLD, inPoint, layerIn, 1);
+		addValues(shown, off);
+	}
+	addSegment(OF_BAKED_HOLD, MAX(layerIn, inPoint), (layerOut < outPoint) ? layerOut : MAX(layerIn, inPoint), 1);
+	addValues(shown, on);
+	if(layerOut < outPoint){
+		addSegment(OF_BAKED_HOLD, layerOut, layerOut, 1);
+		addValues(shown, off);
+	}
+}
+
+void ofxLottieImporter::bakeProperty(const string &iName, int iProperty, const ofxLottieChannelMap &iMap, float iTimeOffset)
+{
+	vector<ofxLottieKey> keys;
+	if((iProperty < 0) || !readKeys(iProperty, keys)) return;
+
+	beginTrack(iName, iMap);
+	vector<float> vals;
+	for(int i=0; i + 1 < (int)keys.size(); i++){
+		const ofxLottieKey &key = keys[i];
+		float t0 = key.time + iTimeOffset;
+		float t1 = keys[i + 1].time + iTimeOffset;
+		if(t1 <= t0) continue;
+
+		if(key.isHold){
+			addSegment(OF_BAKED_HOLD, t0, t1, 1);
+			addValues(iMap, key.startVals);
+			continue;
+		}
+
+		//a cubic matches the ease exactly when the handles' x are at thirds, or on the diagonal
+		const vector<float> &endVals = key.endVals.empty() ? keys[i + 1].startVals : key.endVals;
+		bool isExact = key.outTangent.empty() && (endVals.size() >= key.startVals.size());
+		vector<float> outY(key.startVals.size()), inY(key.startVals.size());
+		for(int d=0; isExact && (d < (int)key.startVals.size()); d++){
+			float ox = getHandle(key.outX, d, 0), oy = getHandle(key.outY, d, 0);
+			float ix = getHandle(key.inX, d, 1.0), iy = getHandle(key.inY, d, 1.0);
+			if((ox == oy) && (ix == iy)){
+				outY[d] = 1.0/3;
+				inY[d] = 2.0/3;
+			}
+			else if((fabsf(ox - 1.0/3) < 1e-3f) && (fabsf(ix - 2.0/3) < 1e-3f)){
+				outY[d] = oy;
+				inY[d] = iy;
+			}
+			else
+				isExact = false;
+		}
+
+		if(isExact){
+			addSegment(OF_BAKED_CUBIC, t0, t1, 0);
+			addCubicValues(iMap, key.startVals, endVals, outY, inY);
+		}
+		else{
+			int numSamples = MAX(2, (int)ceilf((t1 - t0)*oversampling) + 1);
+			addSegment(OF_BAKED_SAMPLED, t0, t1, numSamples);
+			for(int s=0; s < numSamples; s++){
+				evaluateKey(keys, i, (float)s/(numSamples - 1), vals);
+				addValues(iMap, vals);
+			}
+		}
+	}
+
+	//hold the last value
+	const ofxLottieKey &last = keys.back();
+	addSegment(OF_BAKED_HOLD, last.time + iTimeOffset, last.time + iTimeOffset, 1);
+	addValues(iMap, last.startVals);
+}
+
+//Positions with separate x, y and z properties are sampled between the keys of all three.
+void ofxLottieImporter::bakeSplitPosition(const string &iName, int iProperty, const ofxLottieChannelMap &iMap, float iTimeOffset)
+{
+	vector<ofxLottieKey> keys[3];
+	const char *members[3] = {"x", "y", "z"};
+	vector<float> times;
+	for(int d=0; d < 3; d++){
+		readKeys(getMember(iProperty, members[d]), keys[d]);
+		for(unsigned int i=0; i < keys[d].size(); i++)
+			times.push_back(keys[d][i].time);
+	}
+	if(times.empty()) return;
+	sort(times.begin(), times.end());
+	times.erase(unique(times.begin(), times.end()), times.end());
+
+	vector<float> vals(3, 0), dimVals;
+	beginTrack(iName, iMap);
+	for(unsigned int i=0; i < times.size(); i++){
+		float t0 = times[i];
+		float t1 = (i + 1 < times.size()) ? times[i + 1] : t0;
+		int numSamples = (i + 1 < times.size()) ? MAX(2, (int)ceilf((t1 - t0)*oversampling) + 1) : 1;
+		addSegment((numSamples > 1) ? OF_BAKED_SAMPLED : OF_BAKED_HOLD, t0 + iTimeOffset, t1 + iTimeOffset, numSamples);
+
+		for(int s=0; s < numSamples; s++){
+			float frame = (numSamples > 1) ? t0 + (t1 - t0)*s/(numSamples - 1) : t0;
+			for(int d=0; d < 3; d++){
+				if(keys[d].empty()) continue;
+				evaluateKeys(keys[d], frame, dimVals);
+				vals[d] = dimVals[0];
+			}
+			addValues(iMap, vals);
+		}
+	}
+}
+
+//Bakes a solid layer's color, or the color of the first fill among a shape layer's shapes.
+void ofxLottieImporter::bakeColor(const string &iName, int iLayer, float iTimeOffset)
+{
+	ofxLottieChannelMap color = {OF_SETCOLOR, 3, {0, 1, 2, -1}, {255.0, 255.0, 255.0, 1.0}, {0, 0, 0, 0}, {0, 0, 0, 0}};
+
+	int solid = getMember(iLayer, "sc");
+	if(solid >= 0){
+		ofColor c = ofColor::fromHex(strtol(nodes[solid].text.c_str() + ((nodes[solid].text[0] == '#') ? 1 : 0), NULL, 16));
+		vector<float> vals(3);
+		vals[0] = c.r/255.0;
+		vals[1] = c.g/255.0;
+		vals[2] = c.b/255.0;
+		beginTrack(iName, color);
+		addSegment(OF_BAKED_HOLD, inPoint, inPoint, 1);
+		addValues(color, vals);
+		return;
+	}
+
+	int fill = findFill(getMember(iLayer, "shapes"));
+	if(fill < 0) return;
+	int c = getMember(fill, "c");
+
+	//old exports use 0-255, which any key above 1 gives away
+	vector<ofxLottieKey> keys;
+	if(readKeys(c, keys)){
+		for(unsigned int k=0; k < keys.size(); k++){
+			for(unsigned int i=0; i < keys[k].startVals.size(); i++){
+				if(keys[k].startVals[i] > 1.0) color.scale[0] = color.scale[1] = color.scale[2] = 1.0;
+			}
+			for(unsigned int i=0; i < keys[k].endVals.size(); i++){
+				if(keys[k].endVals[i] > 1.0) color.scale[0] = color.scale[1] = color.scale[2] = 1.0;
+			}
+		}
+	}
+	bakeProperty(iName, c, color, iTimeOffset);
+}
+
+int ofxLottieImporter::findFill(int iShapes)
+{
+	if((iShapes < 0) || (nodes[iShapes].type != JSON_ARRAY)) return -1;
+
+	for(int s=nodes[iShapes].firstChild; s >= 0; s=nodes[s].nextSibling){
+		int type = getMember(s, "ty");
+		if(type < 0) continue;
+		if(nodes[type].text == "fl") return s;
+		if(nodes[type].text == "gr"){
+			int fill = findFill(getMember(s, "it"));
+			if(fill >= 0) return fill;
+		}
+	}
+
+	return -1;
+}
+
+void ofxLottieImporter::beginTrack(const string &iName, const ofxLottieChannelMap &iMap)
+{
+	//layers' tracks share their name
+	uint32_t nameOffset = 0;
+	for(size_t i=0; i < names.size(); i += strlen(names.c_str() + i) + 1){
+		if(iName == names.c_str() + i){
+			nameOffset = (uint32_t)i;
+			break;
+		}
+		if(i + strlen(names.c_str() + i) + 1 >= names.size()){
+			nameOffset = (uint32_t)names.size();
+			names.append(iName);
+			names += '\0';
+			break;
+		}
+	}
+
+	ofxBakedTrack track;
+	track.nameOffset = nameOffset;
+	track.id = iMap.id;
+	track.numChannels = iMap.numChannels;
+	track.firstSegment = (uint32_t)segments.size();
+	track.numSegments = 0;
+	tracks.push_back(track);
+}
+
+void ofxLottieImporter::addSegment(int iType, float iStartFrame, float iEndFrame, int iNumSamples)
+{
+	ofxBakedSegment segment;
+	segment.startTime = toSeconds(iStartFrame);
+	segment.duration = (iEndFrame - iStartFrame)/frameRate;
+	segment.type = iType;
+	segment.numSamples = iNumSamples;
+	segment.firstValue = (uint32_t)values.size();
+	segments.push_back(segment);
+	tracks.back().numSegments++;
+}
+
+void ofxLottieImporter::addValues(const ofxLottieChannelMap &iMap, const vector<float> &iVals)
+{
+	for(int c=0; c < iMap.numChannels; c++){
+		int d = iMap.source[c];
+		if((d < 0) || (d >= (int)iVals.size()))
+			values.push_back(iMap.defaults[c]);
+		else
+			values.push_back(iMap.scale[c]*iVals[d] + iMap.offset[c]);
+	}
+}
+
+//Coefficients of v0 + (v1 - v0)*y(u), where y is the bezier (0, iOutY, iInY, 1).
+void ofxLottieImporter::addCubicValues(const ofxLottieChannelMap &iMap, const vector<float> &iStartVals, const vector<float> &iEndVals,
+									   const vector<float> &iOutY, const vector<float> &iInY)
+{
+	for(int c=0; c < iMap.numChannels; c++){
+		int d = iMap.source[c];
+		if((d < 0) || (d >= (int)iStartVals.size())){
+			values.push_back(iMap.defaults[c]);
+			values.push_back(0);
+			values.push_back(0);
+			values.push_back(0);
+			continue;
+		}
+
+		float delta = iMap.scale[c]*(iEndVals[d] - iStartVals[d]);
+		values.push_back(iMap.scale[c]*iStartVals[d] + iMap.offset[c]);
+		values.push_back(delta*3*iOutY[d]);
+		values.push_back(delta*(3*iInY[d] - 6*iOutY[d]));
+		values.push_back(delta*(3*iOutY[d] - 3*iInY[d] + 1.0));
+	}
+}
@@ -0,0 +1,134 @@
+/*
+ofxLottieImporter
+
+Bakes the layer transforms of an After Effects composition, exported as Lottie (Bodymovin) JSON, into ofxBakedTracks.
+Each layer gets tracks for position, rotation, scale and opacity, its in/out points as a show track, and the color of
+its first fill (or of a solid layer). Linear, hold and cubic-bezier keys become hold or cubic segments where they can be
+matched exactly, and are otherwise sampled oversampling times per frame.
+Positions are converted from After Effects' top-left, y-down pixels to the scene's centered, y-up coordinates unless
+isCentered is turned off. Parented layers are baked relative to their parent, so add their objects as children of the
+parent's object. Anchor points, 3D x/y rotation, masks, expressions, precomp contents, time stretch (sr) and
+time remapping (tm) are not imported.
+
+Typically run once, offline:
+  ofxLottieImporter importer;
+  if(importer.load("intro.json")) importer.save("intro.tracks");
+and at startup:
+  tracks.load("intro.tracks");
+  tracks.bind("Logo", logo);
+  animation.addBakedTracks(&tracks);
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "ofxBakedTracks.h"
+
+//A parsed JSON value. Children are linked by index into ofxLottieImporter::nodes.
+struct ofxLottieNode
+{
+	int								type;
+	double							number;
+	string							text;			//string value
+	string							key;			//name of this member in its parent object
+	int								firstChild;
+	int								lastChild;
+	int								nextSibling;
+};
+
+//One keyframe of an animated property, with values still in After Effects units.
+struct ofxLottieKey
+{
+	float							time;			//composition frames
+	vector<float>					startVals;
+	vector<float>					endVals;		//empty if the next key's startVals are used
+	bool							isHold;
+	vector<float>					outX, outY,		//ease handles, one per dimension or shared
+									inX, inY;
+	vector<float>					outTangent,		//motion path tangents, empty if straight
+									inTangent;
+};
+
+//Maps a property's dimensions to a track's channels: channel c = scale[c]*dimension[source[c]] + offset[c].
+struct ofxLottieChannelMap
+{
+	int								id;
+	int								numChannels;
+	int								source[4];		//-1 or a missing dimension uses defaults[c]
+	float							scale[4];
+	float							offset[4];
+	float							defaults[4];
+};
+
+class ofxLottieImporter
+{
+public:
+	ofxLottieImporter();
+
+	bool							load(string iPath);
+	bool							parse(const string &iJson);
+	bool							save(string iPath);
+	bool							getTracks(ofxBakedTracks *oTracks);
+	int								getNumTracks(){ return (int)tracks.size(); }
+
+protected:
+	//JSON
+	int								parseValue(const string &iJson, size_t &ioPos, int iDepth=0);
+	bool							parseString(const string &iJson, size_t &ioPos, string &oText);
+	int								addNode(int iType);
+	void							addChild(int iParent, int iChild);
+	int								getMember(int iNode, const char *iKey);
+	double							getNumber(int iNode, const char *iKey, double iDefault);
+	void							getNumbers(int iNode, vector<float> &oVals);
+
+	//Keyframes
+	bool							readKeys(int iProperty, vector<ofxLottieKey> &oKeys);
+	void							evaluateKey(const vector<ofxLottieKey> &iKeys, int iKey, float iU, vector<float> &oVals);
+	void							evaluateKeys(const vector<ofxLottieKey> &iKeys, float iFrame, vector<float> &oVals);
+	static float					ease(float iOutX, float iOutY, float iInX, float iInY, float iU);
+
+	//Baking
+	void							bakeLayer(int iLayer);
+	void							bakeProperty(const string &iName, int iProperty, const ofxLottieChannelMap &iMap, float iTimeOffset);
+	void							bakeSplitPosition(const string &iName, int iProperty, const ofxLottieChannelMap &iMap, float iTimeOffset);
+	void							bakeColor(const string &iName, int iLayer, float iTimeOffset);
+	int								findFill(int iShapes);
+	void							beginTrack(const string &iName, const ofxLottieChannelMap &iMap);
+	void							addSegment(int iType, float iStartFrame, float iEndFrame, int iNumSamples);
+	void							addValues(const ofxLottieChannelMap &iMap, const vector<float> &iVals);
+	void							addCubicValues(const ofxLottieChannelMap &iMap, const vector<float> &iStartVals, const vector<float> &iEndVals,
+												   const vector<float> &iOutY, const vector<float> &iInY);
+	float							toSeconds(float iFrame){ return (iFrame - inPoint)/frameRate; }
+
+public:
+	bool							isCentered;		//convert positions to the scene's centered, y-up coordinates
+	int								oversampling;	//samples per frame for segments that can't be baked exactly
+	float							width,
+									height,
+									frameRate,
+									inPoint,
+									outPoint;
+
+protected:
+	vector<ofxLottieNode>			nodes;
+	vector<ofxBakedTrack>			tracks;
+	vector<ofxBakedSegment>			segments;
+	vector<float>					values;
+	string							names;
+};
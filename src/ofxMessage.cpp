@@ -1,148 +1,186 @@
 #include "ofxMessage.h"
 #include "ofUtils.h"
+#include "ofxMessageTimeline.h"
+#include "ofxClock.h"
+#include "ofxObject.h"
+#include "ofxTask.h"
 
 //float ofxMessage::OF_RELATIVE_VAL = 9999.9f;
 
-ofxMessage::ofxMessage(int iID, void *iVals, int iInterpolation, float iDuration, float iDelay, int iPlayMode)
+//number of messages carved out of the heap at a time when the pool runs dry
+static const int POOL_CHUNK_SIZE = 256;
+
+void *ofxMessage::poolFreeList = NULL;
+int ofxMessage::poolNumFree = 0;
+vector<char *> ofxMessage::poolChunks;
+unsigned int ofxMessage::numGenerations = 0;
+
+ofxMessage::ofxMessage(int iID, const ofVec4f &iVals, int iInterpolation, float iDuration, float iDelay, int iPlayMode)
 {
-	id = iID;
+	init(iID, iInterpolation, iDuration, iDelay, iPlayMode);
 	baseEndVals = iVals;
-	path = OF_LINEAR_PATH;
-	playMode = iPlayMode;
-	loopDirection = false;
+}
 
-	//startVals = NULL;
-	//initialize all start values to OF_RELATIVE_VAL
-	if((id==OF_SCALE) || (id==OF_SETALPHA)){
-		float *val = (float *)malloc(sizeof(float));
-		val[0] = 0;
-		startVals = (void *)val;
-
-		float *baseVal = (float *)malloc(sizeof(float));
-		baseVal[0] = OF_RELATIVE_VAL;
-		baseStartVals = (void *)baseVal;
-
-		float *end = (float *)malloc(sizeof(float));
-		end[0] = 0;
-		endVals = (void *)end;		
-		
-	}else if((id==OF_TRANSLATE) || (id==OF_ROTATE) || (id==OF_SETCOLOR) || (id==OF_SCALE3)){
-		ofVec3f *vals = (ofVec3f *)malloc(sizeof(ofVec3f));
-		vals->set(0,0,0);
-		startVals = (void *)vals;
-
-		ofVec3f *baseVal = (ofVec3f *)malloc(sizeof(ofVec3f));
-		baseVal->set(OF_RELATIVE_VAL, OF_RELATIVE_VAL, OF_RELATIVE_VAL);
-		baseStartVals = (void *)baseVal;
-
-		ofVec3f *end = (ofVec3f *)malloc(sizeof(ofVec3f));
-		end->set(0,0,0);
-		endVals = (void *)end;
-	}else if(id==OF_SETCOLOR4){
-		ofVec4f *vals = (ofVec4f *)malloc(sizeof(ofVec3f));
-		vals->set(0,0,0,0);
-		startVals = (void *)vals;
-    
-		ofVec4f *baseVal = (ofVec4f *)malloc(sizeof(ofVec3f));
-		baseVal->set(OF_RELATIVE_VAL, OF_RELATIVE_VAL, OF_RELATIVE_VAL, OF_RELATIVE_VAL);
-		baseStartVals = (void *)baseVal;
-    
-		ofVec4f *end = (ofVec4f *)malloc(sizeof(ofVec3f));
-		end->set(0,0,0,0);
-		endVals = (void *)end;
-  }else{
-		startVals = NULL;
-		baseStartVals = NULL;
-		endVals = NULL;
+//Older interface: iVals points at a float[1], ofVec3f or ofVec4f allocated with new, depending on iID.
+//The values are copied in and the allocation is released right away.
+ofxMessage::ofxMessage(int iID, void *iVals, int iInterpolation, float iDuration, float iDelay, int iPlayMode)
+{
+	init(iID, iInterpolation, iDuration, iDelay, iPlayMode);
+
+	if(iVals){
+		int numVals = getNumVals(iID);
+		if(numVals == 1){
+			baseEndVals.set(((float *)iVals)[0], 0, 0, 0);
+			delete[] (float *)iVals;
+		}else if(numVals == 3){
+			ofVec3f *vals = (ofVec3f *)iVals;
+			baseEndVals.set(vals->x, vals->y, vals->z, 0);
+			delete vals;
+		}else if(numVals == 4){
+			baseEndVals = *(ofVec4f *)iVals;
+			delete (ofVec4f *)iVals;
+		}
 	}
-
-	interpolation = iInterpolation;
-	duration = iDuration;
-	startDelay = iDelay;
-	startTime = ofGetElapsedTimef();	//default to current time
-	
-	isEnabled = true;	
-	isRunning = false;
-	autoDelete = true;	
 }
 
-ofxMessage::ofxMessage(int iID, int iInterpolation, int iPath, vector<ofVec4f> iPathPoints, float iDuration, float iDelay, int iPlayMode)
+ofxMessage::ofxMessage(int iID, int iInterpolation, int iPath, const vector<ofVec4f> &iPathPoints, float iDuration, float iDelay, int iPlayMode)
 {
-	id = iID;	
+	init(iID, iInterpolation, iDuration, iDelay, iPlayMode);
 	path = iPath;
 	pathPoints = iPathPoints;
-	playMode = iPlayMode;
-	loopDirection = false;
+	pathCurve.setup(iPath, pathPoints);
+}
 
-	baseEndVals = NULL;
-	startVals = NULL;
-	baseStartVals = NULL;
-	endVals = NULL;
+ofxMessage::ofxMessage(int iID, float (*iFunction)(void *), void *iArgs, float iDelay, int iPlayMode) //LM
+{
+	init(iID, OF_LINEAR, 0, iDelay, iPlayMode);
+	functionPtr = iFunction;
+	functionArgs = iArgs;
+}
 
-	interpolation = iInterpolation;
-	duration = iDuration;
-	startDelay = iDelay;
-	startTime = ofGetElapsedTimef();	//default to current time
-    
-	isEnabled = true;	
-	isRunning = false;
-	autoDelete = true;	
+ofxMessage::~ofxMessage()
+{
+	if(timeline) timeline->remove(this);
+	if(owner) owner->detachMessage(this);
+	ofxTask::messageFinished(this);
+	generation = 0;
+  //DEV: should we delete functionPtr?
 }
 
-ofxMessage::ofxMessage(int iID, float (*iFunction)(void *), void *iArgs, float iDelay, int iPlayMode) //LM
+void ofxMessage::init(int iID, int iInterpolation, float iDuration, float iDelay, int iPlayMode)
 {
 	id = iID;
 	path = OF_LINEAR_PATH;
 	playMode = iPlayMode;
 	loopDirection = false;
-    
-    functionPtr = iFunction;
-    startVals = iArgs;
-    baseStartVals = NULL;
-    endVals = NULL;
-    baseEndVals = NULL;
-    
-	interpolation = NULL;
-	duration = 0;
+
+	//start values default to OF_RELATIVE_VAL, so they're picked up from the object when the message starts
+	startVals.set(0, 0, 0, 0);
+	baseStartVals.set(OF_RELATIVE_VAL, OF_RELATIVE_VAL, OF_RELATIVE_VAL, OF_RELATIVE_VAL);
+	endVals.set(0, 0, 0, 0);
+	baseEndVals.set(0, 0, 0, 0);
+
+	functionPtr = NULL;
+	functionArgs = NULL;
+	timeline = NULL;
+	trackIndex = -1;
+	heapIndex = -1;
+	owner = NULL;
+	ownerIndex = -1;
+	prevOfType = NULL;
+	nextOfType = NULL;
+	//never 0, which marks a deleted message
+	if(++numGenerations == 0) numGenerations = 1;
+	generation = numGenerations;
+
+	interpolation = iInterpolation;
+	duration = iDuration;
 	startDelay = iDelay;
-	startTime = ofGetElapsedTimef();	//default to current time
-	
-	isEnabled = true;	
+	startTime = ofxClock::getCurrentTime();	//default to current scene time
+
+	isEnabled = true;
 	isRunning = false;
-	autoDelete = true;	
+	autoDelete = true;
+	isOrientedToPath = false;
 }
 
-ofxMessage::~ofxMessage()
+ofxMessageHandle ofxMessage::getHandle()
 {
-  if(startVals) free(startVals);
-	if(baseStartVals) free(baseStartVals);
-	if(endVals) free(endVals);
-  
-  // Since baseEndVals was created with 'new', we must cast them back to their original type (Message1f/float, Message3f/ofVec3f) in order to destroy them correctly based on type.
-  if(baseEndVals) {
-    if(id==OF_SETALPHA){
-      delete[] (float *)baseEndVals;
-            //cout<<"* OF_SETALPHA * baseEndVals = "<< baseEndVals <<endl;
-    } else if(id==OF_SCALE){
-      delete[] (float *)baseEndVals;
-            //cout<<"* OF_SCALE * baseEndVals = "<< baseEndVals <<endl;
-    } else if(id==OF_TRANSLATE){
-      delete (ofVec3f *)baseEndVals;
-            //cout<<"* OF_TRANSLATE * baseEndVals = "<< baseEndVals <<endl;
-    } else if(id==OF_ROTATE){
-      delete (ofVec3f *)baseEndVals;
-            //cout<<"* OF_ROTATE * baseEndVals = "<< baseEndVals <<endl;
-    } else if(id==OF_SCALE3){
-      delete (ofVec3f *)baseEndVals;
-            //cout<<"* OF_SCALE3 * baseEndVals = "<< baseEndVals <<endl;
-    } else if(id==OF_SETCOLOR){
-      delete (ofVec3f *)baseEndVals;
-            //cout<<"* OF_SETCOLOR * baseEndVals = "<< baseEndVals <<endl;
-    }
-  }
-  
-  //DEV: should we delete functionPtr?
-  
+	ofxMessageHandle handle;
+	handle.message = this;
+	handle.generation = generation;
+
+	return handle;
+}
+
+//Pooled memory is never given back, so a deleted message's generation can still be read safely.
+ofxMessage* ofxMessageHandle::get()
+{
+	if(message && (generation != 0) && (message->generation == generation))
+		return message;
+
+	return NULL;
+}
+
+void* ofxMessage::operator new(size_t iSize)
+{
+	//anything bigger (a subclass) goes through the regular allocator
+	if(iSize != sizeof(ofxMessage))
+		return ::operator new(iSize);
+
+	if(poolNumFree == 0)
+		reserve(POOL_CHUNK_SIZE);
+
+	void *block = poolFreeList;
+	poolFreeList = *(void **)block;
+	poolNumFree--;
+
+	return block;
+}
+
+void ofxMessage::operator delete(void *iPtr, size_t iSize)
+{
+	if(iPtr == NULL) return;
+
+	if(iSize != sizeof(ofxMessage)){
+		::operator delete(iPtr);
+		return;
+	}
+
+	*(void **)iPtr = poolFreeList;
+	poolFreeList = iPtr;
+	poolNumFree++;
+}
+
+//Makes sure at least iNumMessages can be created without allocating.
+//Call it up front when a scene is about to spawn a large batch of tweens.
+void ofxMessage::reserve(int iNumMessages)
+{
+	int numNew = iNumMessages - poolNumFree;
+	if(numNew <= 0) return;
+
+	char *chunk = (char *)::operator new(sizeof(ofxMessage) * numNew);
+	poolChunks.push_back(chunk);
+
+	for(int i = numNew - 1; i >= 0; i--){
+		void *block = chunk + i * sizeof(ofxMessage);
+		*(void **)block = poolFreeList;
+		poolFreeList = block;
+	}
+	poolNumFree += numNew;
+}
+
+//Returns how many value components a message of type iID animates.
+int ofxMessage::getNumVals(int iID)
+{
+	if((iID == OF_SCALE) || (iID == OF_SETALPHA))
+		return 1;
+	else if((iID == OF_TRANSLATE) || (iID == OF_ROTATE) || (iID == OF_SETCOLOR) || (iID == OF_SCALE3))
+		return 3;
+	else if(iID == OF_SETCOLOR4)
+		return 4;
+
+	return 0;
 }
 
 float ofxMessage::getFinishTime()
@@ -153,238 +191,211 @@ float ofxMessage::getFinishTime()
 void ofxMessage::setStartTime(float iTime)
 {
 	startTime = iTime;
+	if(timeline) timeline->sync(this);
 }
 
 void ofxMessage::enableMessage(bool iEnable)
 {
 	isEnabled = iEnable;
+	if(timeline) timeline->sync(this);
+}
+
+//Translation path messages also turn the object to face along the path (rotation about z).
+void ofxMessage::enableOrientToPath(bool iEnable)
+{
+	isOrientedToPath = iEnable;
+	if(timeline) timeline->sync(this);
 }
 
-//these three methods set the start values and allocate memory for them if they are still null 
 void ofxMessage::setStartVals(float iX)
 {
-	if(startVals == NULL){	
-		float *val = (float *)malloc(sizeof(float));
-		val[0] = iX;
-		startVals = (void *)val;
-		//printf("ofxMessage::setStartVals(%f) - NULL\n", iX);
-	}else{
-		((float *)startVals)[0] = iX;
-		//printf("ofxMessage::setStartVals(%f)\n", iX);
-	}
+	startVals.x = iX;
 }
 
 void ofxMessage::setStartVals(float iX, float iY, float iZ)
 {
-	if(startVals == NULL){						
-		ofVec3f *vals = (ofVec3f *)malloc(sizeof(ofVec3f));
-		vals->set(iX, iY, iZ);
-		startVals = (void *)vals;
-		//printf("ofxMessage::setStartVals(%f, %f, %f) - NULL\n", ((ofVec3f *)startVals)->x, ((ofVec3f *)startVals)->y, ((ofVec3f *)startVals)->z);
-	}else{
-		((ofVec3f *)startVals)->set(iX, iY, iZ);		
-		//printf("ofxMessage::setStartVals(%f, %f, %f) - NULL\n", ((ofVec3f *)startVals)->x, ((ofVec3f *)startVals)->y, ((ofVec3f *)startVals)->z);
-	}
+	startVals.set(iX, iY, iZ, startVals.w);
 }
 
 void ofxMessage::setStartVals(float iX, float iY, float iZ, float iW)
 {
-	if(startVals == NULL){						
-		ofVec4f *vals = (ofVec4f *)malloc(sizeof(ofVec4f));
-		vals->set(iX, iY, iZ, iW);
-		startVals = (void *)vals;
-	}else{
-		((ofVec4f *)startVals)->set(iX, iY, iZ, iW);
-	}
+	startVals.set(iX, iY, iZ, iW);
 }
 
 void ofxMessage::setBaseStartVals(float iX)
 {
-	if(baseStartVals)
-		((float *)baseStartVals)[0] = iX;
+	baseStartVals.x = iX;
 }
 
 void ofxMessage::setBaseStartVals(float iX, float iY, float iZ)
 {
-	if(baseStartVals)
-		((ofVec3f *)baseStartVals)->set(iX, iY, iZ);
+	baseStartVals.set(iX, iY, iZ, baseStartVals.w);
 }
 
 void ofxMessage::setBaseStartVals(float iX, float iY, float iZ, float iW)
 {
-	((ofVec4f *)baseStartVals)->set(iX, iY, iZ, iW);
+	baseStartVals.set(iX, iY, iZ, iW);
 }
 
 void ofxMessage::setEndVals(float iX)
 {
-	if(endVals)
-		((float *)endVals)[0] = iX;
+	endVals.x = iX;
 }
 
 void ofxMessage::setEndVals(float iX, float iY, float iZ)
 {
-	if(endVals)
-		((ofVec3f *)endVals)->set(iX, iY, iZ);
+	endVals.set(iX, iY, iZ, endVals.w);
 }
 
 void ofxMessage::setEndVals(float iX, float iY, float iZ, float iW)
 {
-	if(endVals)
-		((ofVec4f *)endVals)->set(iX, iY, iZ, iW);
+	endVals.set(iX, iY, iZ, iW);
 }
 
 
-//static method for interpolating time 
-float ofxMessage::interpolateTime(int iInterp, float iTime)
-{	
-	if (iTime >= 1.0f){
-		//iTime = 1.0f;
-		return 1.0f;
-	}else if(iTime < 0){
-		return 0.0f;
-	}
+//easing curves ______________________________________________________________________________________
 
-	switch (iInterp) {
-		case OF_LINEAR:		
-			return (iTime);
-			break;
-		case OF_EASE_OUT:		
-			return (1.0f-(iTime-1.0f)*(iTime-1.0f));		
-			break;
-		case OF_EASE_IN:
-			return (iTime*iTime);
-			break;
-		case (OF_EASE_INOUT):	
-			if (iTime <= 0.5f) {
-				return((iTime*2.0f)*(iTime*2.0f)*0.5f);
-			} 
-			else if (iTime > 0.5f) {
-				return((1.0f-((iTime-0.5f)*2.0f-1.0f)*((iTime-0.5f)*2.0f-1.0f))*0.5f + 0.5f);
-			}
-			break;	
-	}
+//samples per cubic-bezier easing table
+static const int BEZIER_TABLE_SIZE = 256;
 
-	return iTime;
-}
+vector<float> ofxMessage::cubicBezierTables;
 
+//Curves are written as their ease-in form, ease-out and ease-in-out are derived from it.
+static inline float easeInQuad(float t){ return t*t; }
+static inline float easeInCubic(float t){ return t*t*t; }
+static inline float easeInQuart(float t){ return t*t*t*t; }
+static inline float easeInExpo(float t){ return (t <= 0) ? 0 : powf(2.0f, 10.0f*t - 10.0f); }
 
+static inline float easeInBack(float t)
+{
+	const float c1 = 1.70158f;
+	return (c1 + 1.0f)*t*t*t - c1*t*t;
+}
 
-//iM goes from 0 - 1.0
-ofVec4f ofxMessage::bezier(float iM, std::vector<ofVec4f> iPath) 
-{
-	ofVec4f r;
-	
-	//if (iM > 1.0) iM = 1.0;
-	if (iM > 0.999) iM = 0.999;
-
-	int n = iPath.size()-1;
-	int k,kn,nn,nkn;
-	double blend,muk,munk;
-	float bx = 0;
-	float by = 0;
-	float bz = 0;
-	float bw = 0;
-
-	muk = 1;
-	munk = pow(1.0 - (double)iM, (double)n);
-
-	for (k = 0; k <= n; k++) {
-		nn = n;
-		kn = k;
-		nkn = n - k;
-		blend = muk * munk;
-		muk *= iM;
-		munk /= (1-iM);
-		while (nn >= 1) {
-			blend *= nn;
-			nn--;
-			if (kn > 1) {
-				blend /= (double)kn;
-				kn--;
-			}
-			if (nkn > 1) {
-				blend /= (double)nkn;
-				nkn--;
-			}
-		}    
-		bx += iPath[k].x * blend;
-		by += iPath[k].y * blend;
-		bz += iPath[k].z * blend;
-		bw += iPath[k].w * blend;
-	}
+static inline float easeInElastic(float t)
+{
+	if((t <= 0) || (t >= 1)) return t;
+	return -powf(2.0f, 10.0f*t - 10.0f) * sinf((10.0f*t - 10.75f) * (float)(TWO_PI/3.0));
+}
 
-	r.set(bx, by, bz, bw);
+template<float (*EaseIn)(float)> static inline float easeOut(float t){ return 1.0f - EaseIn(1.0f - t); }
+template<float (*EaseIn)(float)> static inline float easeInOut(float t){ return (t < 0.5f) ? 0.5f*EaseIn(2.0f*t) : 1.0f - 0.5f*EaseIn(2.0f - 2.0f*t); }
 
-	return(r);
+//One tight loop per curve; times are clamped to [0, 1] and the ends are exact.
+template<float (*Ease)(float)> static void easeAll(const float *iTimes, float *oTimes, int iNum)
+{
+	for(int i = 0; i < iNum; i++){
+		float t = iTimes[i];
+		t = (t < 0) ? 0 : ((t > 1.0f) ? 1.0f : t);
+		oTimes[i] = (t >= 1.0f) ? 1.0f : Ease(t);
+	}
 }
 
+static inline float easeLinear(float t){ return t; }
 
-ofVec4f ofxMessage::spline(float iM, std::vector<ofVec4f> iPath) 
+//static method for interpolating time 
+float ofxMessage::interpolateTime(int iInterp, float iTime)
 {
-	ofVec4f r;
-
-	float p0, p1, p2, p3;
-	float xx, yy, zz, ww;
-	int nPoint;
 	float t;
+	interpolateTimes(iInterp, &iTime, &t, 1);
+	return t;
+}
 
-	// first figure out which two points you are between on the entire spline /////////
-	nPoint = (int)(iM * (float)(iPath.size() - 1));	
-	
-	// then figure out how far along you are between the adjacent control points //////
-	float step = 1.0f/(float)(iPath.size() - 1);
-	t = fmod((float)iM, step)/step;
-	
-	// check to see if you're at the boundaries ////////////////////////////////////////
-	int nPointPrev = nPoint - 1;
-	int nPointNext = nPoint + 1;
-	int nPointNextNext = nPoint + 2;
-
-	if(nPointPrev < 0){
-		nPointPrev = 0;
-	}	
-	else if(nPointNext > ((int)iPath.size() - 1)){
-		nPointNext = (int)iPath.size() - 1;
-		nPointNextNext = nPointNext;
-	}
-	else if(nPointNextNext > ((int)iPath.size() - 1)){
-		nPointNextNext = (int)iPath.size() - 1;
+//Eases iNum times with the same curve.
+void ofxMessage::interpolateTimes(int iInterp, const float *iTimes, float *oTimes, int iNum)
+{
+	switch (iInterp) {
+		case OF_LINEAR:				easeAll<easeLinear>(iTimes, oTimes, iNum); break;
+		case OF_EASE_IN:			easeAll<easeInQuad>(iTimes, oTimes, iNum); break;
+		case OF_EASE_OUT:			easeAll<easeOut<easeInQuad> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_INOUT:			easeAll<easeInOut<easeInQuad> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_IN_CUBIC:		easeAll<easeInCubic>(iTimes, oTimes, iNum); break;
+		case OF_EASE_OUT_CUBIC:		easeAll<easeOut<easeInCubic> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_INOUT_CUBIC:	easeAll<easeInOut<easeInCubic> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_IN_QUART:		easeAll<easeInQuart>(iTimes, oTimes, iNum); break;
+		case OF_EASE_OUT_QUART:		easeAll<easeOut<easeInQuart> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_INOUT_QUART:	easeAll<easeInOut<easeInQuart> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_IN_EXPO:		easeAll<easeInExpo>(iTimes, oTimes, iNum); break;
+		case OF_EASE_OUT_EXPO:		easeAll<easeOut<easeInExpo> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_INOUT_EXPO:	easeAll<easeInOut<easeInExpo> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_IN_BACK:		easeAll<easeInBack>(iTimes, oTimes, iNum); break;
+		case OF_EASE_OUT_BACK:		easeAll<easeOut<easeInBack> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_INOUT_BACK:	easeAll<easeInOut<easeInBack> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_IN_ELASTIC:	easeAll<easeInElastic>(iTimes, oTimes, iNum); break;
+		case OF_EASE_OUT_ELASTIC:	easeAll<easeOut<easeInElastic> >(iTimes, oTimes, iNum); break;
+		case OF_EASE_INOUT_ELASTIC:	easeAll<easeInOut<easeInElastic> >(iTimes, oTimes, iNum); break;
+		default:{
+			int curve = iInterp - OF_EASE_CUBIC_BEZIER;
+			if((curve >= 0) && ((curve + 1)*(BEZIER_TABLE_SIZE + 1) <= (int)cubicBezierTables.size())){
+				//table lookup, linearly interpolated
+				const float *table = &cubicBezierTables[curve*(BEZIER_TABLE_SIZE + 1)];
+				for(int i = 0; i < iNum; i++){
+					float t = iTimes[i];
+					t = (t < 0) ? 0 : ((t > 1.0f) ? 1.0f : t);
+					float x = t*BEZIER_TABLE_SIZE;
+					int k = MIN((int)x, BEZIER_TABLE_SIZE - 1);
+					float f = x - k;
+					oTimes[i] = (t >= 1.0f) ? 1.0f : table[k] + (table[k+1] - table[k])*f;
+				}
+			}else
+				easeAll<easeLinear>(iTimes, oTimes, iNum);
+			break;
+		}
 	}
+}
 
-	// do the spline calculations /////////////////////////////////////////////////////
-	// First calculate the X coefficients
-	p0 = iPath[nPointPrev][0]; 
-	p1 = iPath[nPoint][0];
-	p2 = iPath[nPointNext][0];
-	p3 = iPath[nPointNextNext][0];
-
-	xx = 0.5*((2.0*p1) + (-p0 + p2)*t + (2.0*p0 - 5.0*p1 + 4*p2 - p3)*t*t + (-p0 + 3*p1 - 3.0*p2 + p3)*t*t*t);
-	
-	// Next, the Y coefficients
-	p0 = iPath[nPointPrev][1]; 
-	p1 = iPath[nPoint][1];
-	p2 = iPath[nPointNext][1]; 
-	p3 = iPath[nPointNextNext][1];
+//Eases iNum times with their own curves. Runs of the same curve are eased together.
+void ofxMessage::interpolateTimes(const int *iInterps, const float *iTimes, float *oTimes, int iNum)
+{
+	int i = 0;
+	while(i < iNum){
+		int j = i + 1;
+		while((j < iNum) && (iInterps[j] == iInterps[i])) j++;
+		interpolateTimes(iInterps[i], iTimes + i, oTimes + i, j - i);
+		i = j;
+	}
+}
 
-	yy = 0.5*((2.0*p1) + (-p0 + p2)*t + (2.0*p0 - 5.0*p1 + 4*p2 - p3)*t*t + (-p0 + 3*p1 - 3.0*p2 + p3)*t*t*t);
+//Adds a CSS style cubic-bezier(x1, y1, x2, y2) easing curve and returns its id, to be used like OF_EASE_IN etc.
+//The curve is solved for evenly spaced times once here, so easing with it is a table lookup.
+int ofxMessage::addCubicBezierEasing(float iX1, float iY1, float iX2, float iY2)
+{
+	iX1 = ofClamp(iX1, 0, 1);
+	iX2 = ofClamp(iX2, 0, 1);
+
+	//polynomial coefficients of x(u) and y(u), with end points at 0 and 1
+	double cx = 3.0*iX1, bx = 3.0*(iX2 - iX1) - cx, ax = 1.0 - cx - bx;
+	double cy = 3.0*iY1, by = 3.0*(iY2 - iY1) - cy, ay = 1.0 - cy - by;
+
+	int curve = (int)cubicBezierTables.size()/(BEZIER_TABLE_SIZE + 1);
+	for(int k = 0; k <= BEZIER_TABLE_SIZE; k++){
+		double x = (double)k/BEZIER_TABLE_SIZE;
+
+		//x(u) is monotonic for x1, x2 in [0, 1], so bisection always converges
+		double lo = 0, hi = 1, u = x;
+		for(int it = 0; it < 40; it++){
+			double xu = ((ax*u + bx)*u + cx)*u;
+			if(fabs(xu - x) < 1e-7) break;
+			if(xu < x) lo = u;
+			else hi = u;
+			u = 0.5*(lo + hi);
+		}
+		cubicBezierTables.push_back((float)(((ay*u + by)*u + cy)*u));
+	}
 
-	// Finally, the Z coefficients
-	p0 = iPath[nPointPrev][2]; 
-	p1 = iPath[nPoint][2]; 
-	p2 = iPath[nPointNext][2]; 
-	p3 = iPath[nPointNextNext][2]; 
+	return OF_EASE_CUBIC_BEZIER + curve;
+}
 
-	zz = 0.5*((2.0*p1) + (-p0 + p2)*t + (2.0*p0 - 5.0*p1 + 4*p2 - p3)*t*t + (-p0 + 3*p1 - 3.0*p2 + p3)*t*t*t);
 
-	// Finally, the W coefficients 
-	p0 = iPath[nPointPrev][3]; 
-	p1 = iPath[nPoint][3]; 
-	p2 = iPath[nPointNext][3]; 
-	p3 = iPath[nPointNextNext][3]; 
 
-	ww = 0.5*((2.0*p1) + (-p0 + p2)*t + (2.0*p0 - 5.0*p1 + 4*p2 - p3)*t*t + (-p0 + 3*p1 - 3.0*p2 + p3)*t*t*t);
+//iM goes from 0 - 1.0
+ofVec4f ofxMessage::bezier(float iM, const std::vector<ofVec4f> &iPath) 
+{
+	return ofxMessagePath::bezier(iM, iPath);
+}
 
-	r.set(xx,yy,zz,ww);
 
-	return(r);
-}
\ No newline at end of file
+ofVec4f ofxMessage::spline(float iM, const std::vector<ofVec4f> &iPath) 
+{
+	return ofxMessagePath::spline(iM, iPath);
+}
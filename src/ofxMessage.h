@@ -2,6 +2,8 @@
 ofxMessage
 
 Class used by ofxObject and ofxAnimation to animate ofxObjects. 
+Messages are allocated from a pool that isn't thread-safe, so only create and delete them on the main thread.
+Pool memory is never freed: ofxMessageHandle reads the generation of deleted messages, which relies on it.
 
 Soso OpenFrameworks Addon
 Copyright (C) 2012 Sosolimited
@@ -24,6 +26,26 @@ IN THE SOFTWARE.
 #pragma once
 
 #include "ofVectorMath.h"	
+#include "ofxMessagePath.h"
+
+class ofxMessageTimeline;
+class ofxObject;
+class ofxMessage;
+
+//Refers to a message without keeping it alive. Once the message is deleted, get() returns NULL,
+//even if the pool has handed its memory to a new message.
+class ofxMessageHandle
+{
+public:
+	ofxMessageHandle(){ message = NULL; generation = 0; }
+
+	ofxMessage*				get();
+	bool					isValid(){ return get() != NULL; }
+
+public:
+	ofxMessage				*message;
+	unsigned int			generation;
+};
 
 
 enum{
@@ -40,14 +62,31 @@ enum{
 	OF_SETALPHA,
 	OF_SHOW,
 	OF_HIDE,
-  OF_FUNCTION
+  OF_FUNCTION,
+  OF_NUM_MESSAGE_TYPES
 };
 
 enum{
 	OF_LINEAR,
 	OF_EASE_IN,
 	OF_EASE_OUT,
-	OF_EASE_INOUT
+	OF_EASE_INOUT,
+	OF_EASE_IN_CUBIC,
+	OF_EASE_OUT_CUBIC,
+	OF_EASE_INOUT_CUBIC,
+	OF_EASE_IN_QUART,
+	OF_EASE_OUT_QUART,
+	OF_EASE_INOUT_QUART,
+	OF_EASE_IN_EXPO,
+	OF_EASE_OUT_EXPO,
+	OF_EASE_INOUT_EXPO,
+	OF_EASE_IN_BACK,
+	OF_EASE_OUT_BACK,
+	OF_EASE_INOUT_BACK,
+	OF_EASE_IN_ELASTIC,
+	OF_EASE_OUT_ELASTIC,
+	OF_EASE_INOUT_ELASTIC,
+	OF_EASE_CUBIC_BEZIER = 1000		//ids handed out by ofxMessage::addCubicBezierEasing() start here
 };
 
 enum{
@@ -65,15 +104,23 @@ enum{
 class ofxMessage
 {
 public:
+	ofxMessage(int iID, const ofVec4f &iVals, int iInterpolation, float iDuration, float iDelay=0, int iPlayMode=OF_ONE_TIME_PLAY);
 	ofxMessage(int iID, void *iVals, int iInterpolation, float iDuration, float iDelay=0, int iPlayMode=OF_ONE_TIME_PLAY);
-	ofxMessage(int iID, int iInterpolation, int iPath, vector<ofVec4f> iPathPoints, float iDuration, float iDelay=0, int iPlayMode=OF_ONE_TIME_PLAY);
+	ofxMessage(int iID, int iInterpolation, int iPath, const vector<ofVec4f> &iPathPoints, float iDuration, float iDelay=0, int iPlayMode=OF_ONE_TIME_PLAY);
 	ofxMessage(int iID, float (*iFunction)(void *), void *iArgs, float iDelay, int iPlayMode=OF_ONE_TIME_PLAY); //LM
 
 	~ofxMessage();
 
+	//messages come out of a recycled pool, so spawning tweens doesn't hit malloc
+	static void*	operator new(size_t iSize);
+	static void		operator delete(void *iPtr, size_t iSize);
+	static void		reserve(int iNumMessages);
+
+	ofxMessageHandle		getHandle();
 	float					getFinishTime();
 	void					setStartTime(float iTime);
 	void					enableMessage(bool iEnable);
+	void					enableOrientToPath(bool iEnable);
 	void					setStartVals(float iX);
 	void					setStartVals(float iX, float iY, float iZ);
 	void					setStartVals(float iX, float iY, float iZ, float iW);
@@ -84,9 +131,13 @@ public:
 	void					setEndVals(float iX, float iY, float iZ);
 	void					setEndVals(float iX, float iY, float iZ, float iW);
 
+	static int		getNumVals(int iID);
   static float	interpolateTime(int iInterp, float iTime);
-	static ofVec4f			bezier(float iM, std::vector<ofVec4f> iPath);
-	static ofVec4f			spline(float iM, std::vector<ofVec4f> iPath);
+	static void		interpolateTimes(int iInterp, const float *iTimes, float *oTimes, int iNum);
+	static void		interpolateTimes(const int *iInterps, const float *iTimes, float *oTimes, int iNum);
+	static int		addCubicBezierEasing(float iX1, float iY1, float iX2, float iY2);
+	static ofVec4f			bezier(float iM, const std::vector<ofVec4f> &iPath);
+	static ofVec4f			spline(float iM, const std::vector<ofVec4f> &iPath);
 
 public:
 	int						id;
@@ -97,14 +148,36 @@ public:
 	float					startTime,
                 startDelay,
                 duration;
-	void					*endVals,
-                *baseEndVals,
-                *startVals,
-                *baseStartVals;
+	//values live inline; single values use x, 3 component values use x,y,z
+	ofVec4f				endVals,
+                baseEndVals,
+                startVals,
+                baseStartVals;
   float         (*functionPtr)(void *);
+  void          *functionArgs;
 	bool					autoDelete;
 	bool					isEnabled;
 	bool					isRunning;
+	bool					isOrientedToPath;
 	vector<ofVec4f>		pathPoints;
+	ofxMessagePath		pathCurve;		//precomputed from pathPoints
+	ofxMessageTimeline	*timeline;		//set while the message is scheduled on a timeline
+	int						trackIndex;
+	int						heapIndex;		//position on the timeline's pending heap, -1 once it's running
+	ofxObject				*owner;			//the object whose messages list holds this
+	int						ownerIndex;
+	ofxMessage				*prevOfType,	//the owner's other messages of the same id
+                *nextOfType;
+	unsigned int			generation;		//0 once deleted
+
+private:
+	void					init(int iID, int iInterpolation, float iDuration, float iDelay, int iPlayMode);
+
+	static void		*poolFreeList;
+	static int		poolNumFree;
+	static vector<char *>	poolChunks;
+	static unsigned int		numGenerations;
+
+	static vector<float>	cubicBezierTables;		//BEZIER_TABLE_SIZE+1 samples per curve (see ofxMessage.cpp)
   
 };
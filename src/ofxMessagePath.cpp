@@ -0,0 +1,253 @@
+#include "ofxMessagePath.h"
+#include "ofxMessage.h"
+#include <algorithm>
+
+//table entries per path segment, for arc length lookups
+static const int ARC_SAMPLES_PER_SEGMENT = 64;
+static const int ARC_MAX_SAMPLES = 8192;
+
+ofxMessagePath::ofxMessagePath()
+{
+	type = OF_LINEAR_PATH;
+	numPoints = 0;
+	isConstantSpeed = false;
+}
+
+void ofxMessagePath::setup(int iType, const vector<ofVec4f> &iPoints)
+{
+	type = iType;
+	numPoints = (int)iPoints.size();
+	bezierCoeffs.clear();
+	tangentCoeffs.clear();
+	splineCoeffs.clear();
+	arcLengths.clear();
+	if(numPoints == 0) return;
+
+	int n = numPoints - 1;
+	if(type == OF_BEZIER_PATH){
+		//fold the binomial coefficients into the control points once
+		bezierCoeffs.resize(numPoints*4);
+		double binomial = 1;
+		for(int k = 0; k <= n; k++){
+			for(int c = 0; c < 4; c++)
+				bezierCoeffs[k*4 + c] = binomial * iPoints[k][c];
+			binomial = binomial * (n - k)/(k + 1);
+		}
+
+		//the derivative is a bezier of degree n-1 through n*(P_k+1 - P_k)
+		if(n > 0){
+			tangentCoeffs.resize(n*4);
+			binomial = 1;
+			for(int k = 0; k < n; k++){
+				for(int c = 0; c < 4; c++)
+					tangentCoeffs[k*4 + c] = binomial * n * (iPoints[k+1][c] - iPoints[k][c]);
+				binomial = binomial * (n - 1 - k)/(k + 1);
+			}
+		}
+	}else if(type == OF_SPLINE_PATH){
+		splineCoeffs.resize(MAX(n, 1)*4);
+		if(n == 0){
+			splineCoeffs[3] = iPoints[0];
+		}else{
+			for(int k = 0; k < n; k++){
+				catmullRom(iPoints[MAX(k-1, 0)], iPoints[k], iPoints[k+1], iPoints[MIN(k+2, n)], &splineCoeffs[k*4]);
+			}
+		}
+	}
+
+	if(isConstantSpeed)
+		buildArcLengthTable();
+}
+
+//Moves along the path at an even pace instead of spending equal time between control points.
+void ofxMessagePath::enableConstantSpeed(bool iEnable)
+{
+	isConstantSpeed = iEnable;
+	if(isConstantSpeed && arcLengths.empty())
+		buildArcLengthTable();
+}
+
+//Length of the path in x, y, z.
+float ofxMessagePath::getLength()
+{
+	if(arcLengths.empty())
+		buildArcLengthTable();
+
+	return arcLengths.empty() ? 0 : arcLengths.back();
+}
+
+void ofxMessagePath::buildArcLengthTable()
+{
+	arcLengths.clear();
+	if(numPoints < 2) return;
+
+	int numSamples = MIN((numPoints - 1)*ARC_SAMPLES_PER_SEGMENT, ARC_MAX_SAMPLES);
+	arcLengths.resize(numSamples + 1);
+
+	ofVec4f prev = evaluateParameter(0, NULL);
+	float length = 0;
+	arcLengths[0] = 0;
+	for(int i = 1; i <= numSamples; i++){
+		ofVec4f p = evaluateParameter((float)i/numSamples, NULL);
+		ofVec3f d(p.x - prev.x, p.y - prev.y, p.z - prev.z);
+		length += d.length();
+		arcLengths[i] = length;
+		prev = p;
+	}
+}
+
+//Maps a fraction of the path's length to the curve parameter, by binary search on the arc length table.
+float ofxMessagePath::getParameter(float iM)
+{
+	int last = (int)arcLengths.size() - 1;
+	if((last < 1) || (arcLengths[last] <= 0)) return iM;
+
+	float target = ofClamp(iM, 0, 1) * arcLengths[last];
+	int i = (int)(upper_bound(arcLengths.begin(), arcLengths.end(), target) - arcLengths.begin());
+	i = MIN(MAX(i, 1), last);
+
+	float segment = arcLengths[i] - arcLengths[i-1];
+	float f = (segment > 0) ? (target - arcLengths[i-1])/segment : 0;
+
+	return (i - 1 + f)/last;
+}
+
+ofVec4f ofxMessagePath::evaluate(float iM)
+{
+	return evaluateParameter(isConstantSpeed ? getParameter(iM) : iM, NULL);
+}
+
+ofVec4f ofxMessagePath::evaluate(float iM, ofVec4f &oTangent)
+{
+	return evaluateParameter(isConstantSpeed ? getParameter(iM) : iM, &oTangent);
+}
+
+//Samples the path at iNum positions, e.g. to draw it.
+void ofxMessagePath::evaluate(const float *iM, ofVec4f *oVals, int iNum)
+{
+	for(int i = 0; i < iNum; i++)
+		oVals[i] = evaluate(iM[i]);
+}
+
+ofVec4f ofxMessagePath::evaluateParameter(float iU, ofVec4f *oTangent)
+{
+	ofVec4f r;
+	if(oTangent) oTangent->set(0, 0, 0, 0);
+	if(numPoints == 0) return r;
+
+	float u = ofClamp(iU, 0, 1);
+	if(type == OF_BEZIER_PATH){
+		double v[4];
+		bernstein(&bezierCoeffs[0], numPoints - 1, u, v);
+		r.set(v[0], v[1], v[2], v[3]);
+
+		if(oTangent && !tangentCoeffs.empty()){
+			bernstein(&tangentCoeffs[0], numPoints - 2, u, v);
+			oTangent->set(v[0], v[1], v[2], v[3]);
+		}
+	}else if(type == OF_SPLINE_PATH){
+		int numSegments = (int)splineCoeffs.size()/4;
+		float x = u*numSegments;
+		int k = MIN((int)x, numSegments - 1);
+		float t = x - k;
+
+		const ofVec4f *c = &splineCoeffs[k*4];
+		r = ((c[0]*t + c[1])*t + c[2])*t + c[3];
+		if(oTangent)
+			*oTangent = ((c[0]*(3*t) + c[1]*2)*t + c[2])*numSegments;
+	}
+
+	return r;
+}
+
+//Evaluates sum(iCoeffs[k] * t^k * (1-t)^(n-k)) with Horner's rule in t/(1-t), or (1-t)/t past the midpoint,
+//so the ratio never exceeds 1 and no powers are needed.
+void ofxMessagePath::bernstein(const double *iCoeffs, int iDegree, double iT, double *oVal)
+{
+	int n = iDegree;
+	for(int c = 0; c < 4; c++) oVal[c] = 0;
+
+	if(iT < 0.5){
+		double s = iT/(1.0 - iT);
+		double scale = 1;
+		for(int k = n; k >= 0; k--){
+			for(int c = 0; c < 4; c++)
+				oVal[c] = oVal[c]*s + iCoeffs[k*4 + c];
+			if(k > 0) scale *= (1.0 - iT);
+		}
+		for(int c = 0; c < 4; c++) oVal[c] *= scale;
+	}else{
+		double s = (1.0 - iT)/iT;
+		double scale = 1;
+		for(int k = 0; k <= n; k++){
+			for(int c = 0; c < 4; c++)
+				oVal[c] = oVal[c]*s + iCoeffs[k*4 + c];
+			if(k < n) scale *= iT;
+		}
+		for(int c = 0; c < 4; c++) oVal[c] *= scale;
+	}
+}
+
+//Evaluates a bezier path straight from its control points, in O(n).
+//Path messages use a precomputed ofxMessagePath instead.
+ofVec4f ofxMessagePath::bezier(float iM, const vector<ofVec4f> &iPath)
+{
+	ofVec4f r;
+	int n = (int)iPath.size() - 1;
+	if(n < 0) return r;
+
+	double t = ofClamp(iM, 0, 1);
+	double v[4] = {0, 0, 0, 0};
+	double scale = 1;
+
+	if(t < 0.5){
+		//binomials from C(n,n) down to C(n,0)
+		double s = t/(1.0 - t);
+		double binomial = 1;
+		for(int k = n; k >= 0; k--){
+			for(int c = 0; c < 4; c++)
+				v[c] = v[c]*s + binomial*iPath[k][c];
+			binomial = binomial * k/(n - k + 1);
+			if(k > 0) scale *= (1.0 - t);
+		}
+	}else{
+		double s = (1.0 - t)/t;
+		double binomial = 1;
+		for(int k = 0; k <= n; k++){
+			for(int c = 0; c < 4; c++)
+				v[c] = v[c]*s + binomial*iPath[k][c];
+			binomial = binomial * (n - k)/(k + 1);
+			if(k < n) scale *= t;
+		}
+	}
+
+	r.set(v[0]*scale, v[1]*scale, v[2]*scale, v[3]*scale);
+	return r;
+}
+
+//Coefficients of the Catmull-Rom segment between iP1 and iP2.
+void ofxMessagePath::catmullRom(const ofVec4f &iP0, const ofVec4f &iP1, const ofVec4f &iP2, const ofVec4f &iP3, ofVec4f *oCoeffs)
+{
+	oCoeffs[0] = (iP0*-1 + iP1*3 - iP2*3 + iP3)*0.5f;
+	oCoeffs[1] = (iP0*2 - iP1*5 + iP2*4 - iP3)*0.5f;
+	oCoeffs[2] = (iP2 - iP0)*0.5f;
+	oCoeffs[3] = iP1;
+}
+
+//Evaluates a spline path straight from its control points.
+//Path messages use a precomputed ofxMessagePath instead.
+ofVec4f ofxMessagePath::spline(float iM, const vector<ofVec4f> &iPath)
+{
+	int n = (int)iPath.size() - 1;
+	if(n < 0) return ofVec4f();
+	if(n == 0) return iPath[0];
+
+	float x = ofClamp(iM, 0, 1)*n;
+	int k = MIN((int)x, n - 1);
+	float t = x - k;
+
+	ofVec4f c[4];
+	catmullRom(iPath[MAX(k-1, 0)], iPath[k], iPath[k+1], iPath[MIN(k+2, n)], c);
+
+	return ((c[0]*t + c[1])*t + c[2])*t + c[3];
+}
@@ -0,0 +1,68 @@
+/*
+ofxMessagePath
+
+Precomputed form of a bezier or spline animation path, built once when a path message is created.
+Bezier paths keep their binomial weighted control points, so a sample is a single O(n) Horner pass
+instead of rebuilding the Bernstein weights every frame. Spline paths keep the Catmull-Rom coefficients
+of each segment.
+With constant speed enabled, the path is reparameterized by arc length through a lookup table, so
+objects move along it at an even pace; each sample is then a binary search on the table.
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF 
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "ofVectorMath.h"
+
+class ofxMessagePath
+{
+public:
+	ofxMessagePath();
+
+	void					setup(int iType, const vector<ofVec4f> &iPoints);
+	bool					isSetup(){ return (numPoints > 0); }
+	void					enableConstantSpeed(bool iEnable);
+	float					getLength();
+
+	//iM goes from 0 - 1.0
+	ofVec4f				evaluate(float iM);
+	ofVec4f				evaluate(float iM, ofVec4f &oTangent);		//oTangent is the direction of travel, not normalized
+	void					evaluate(const float *iM, ofVec4f *oVals, int iNum);
+
+	static ofVec4f		bezier(float iM, const vector<ofVec4f> &iPath);
+	static ofVec4f		spline(float iM, const vector<ofVec4f> &iPath);
+
+protected:
+	float					getParameter(float iM);
+	ofVec4f				evaluateParameter(float iU, ofVec4f *oTangent);
+	void					buildArcLengthTable();
+	static void			bernstein(const double *iCoeffs, int iDegree, double iT, double *oVal);
+	static void			catmullRom(const ofVec4f &iP0, const ofVec4f &iP1, const ofVec4f &iP2, const ofVec4f &iP3, ofVec4f *oCoeffs);
+
+public:
+	int						type;
+	int						numPoints;
+	bool					isConstantSpeed;
+
+protected:
+	vector<double>		bezierCoeffs;		//C(n,k) * P_k, 4 per control point
+	vector<double>		tangentCoeffs;		//the same for the derivative's control points
+	vector<ofVec4f>		splineCoeffs;		//a, b, c, d per segment, p(t) = ((a*t + b)*t + c)*t + d
+	vector<float>			arcLengths;			//distance travelled at each table entry, evenly spaced in the parameter
+};
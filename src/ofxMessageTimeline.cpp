@@ -0,0 +1,719 @@
+#include "ofxMessageTimeline.h"
+#include "ofxObject.h"
+#include "ofxTask.h"
+#include <cfloat>
+#include <algorithm>
+
+//tracks per parallel block. Fixed, so blocks don't depend on the number of threads.
+static const int TRACK_BLOCK_SIZE = 2048;
+
+
+//class ofxMessageTracks _____________________________________________________________________________
+
+ofxMessageTracks::ofxMessageTracks()
+{
+	id = 0;
+	numVals = 0;
+	numDead = 0;
+}
+
+int ofxMessageTracks::add(ofxObject *iObject, ofxMessage *iMessage)
+{
+	messages.push_back(iMessage);
+	objects.push_back(iObject);
+	startTimes.push_back(iMessage->startTime + iMessage->startDelay);
+	//zero length messages (show, hide, functions) complete the frame after they start
+	invDurations.push_back((iMessage->duration > 0) ? 1.0f/iMessage->duration : FLT_MAX);
+	interps.push_back(iMessage->interpolation);
+
+	unsigned char flag = 0;
+	if(iMessage->isEnabled) flag |= OF_TRACK_ENABLED;
+	if(iMessage->loopDirection) flag |= OF_TRACK_REVERSED;
+	if(iMessage->path != OF_LINEAR_PATH) flag |= OF_TRACK_PATH;
+	if(iMessage->isOrientedToPath && (id == OF_TRANSLATE) && (iMessage->path != OF_LINEAR_PATH)) flag |= OF_TRACK_ORIENT;
+	flags.push_back(flag);
+
+	times.push_back(0);
+	eased.push_back(0);
+	headings.push_back(0);
+	for(int c = 0; c < numVals; c++){
+		startVals[c].push_back(0);
+		endVals[c].push_back(0);
+		outVals[c].push_back(0);
+	}
+
+	return size() - 1;
+}
+
+//Tracks are only flagged here and compacted after the update, so indices stay valid mid-pass.
+void ofxMessageTracks::kill(int iTrack)
+{
+	if(flags[iTrack] & OF_TRACK_DEAD) return;
+
+	messages[iTrack]->timeline = NULL;
+	messages[iTrack] = NULL;
+	objects[iTrack] = NULL;
+	flags[iTrack] = OF_TRACK_DEAD;
+	numDead++;
+}
+
+void ofxMessageTracks::compact()
+{
+	if(numDead == 0) return;
+
+	int n = size();
+	int j = 0;
+	for(int i = 0; i < n; i++){
+		if(flags[i] & OF_TRACK_DEAD) continue;
+
+		if(j != i){
+			messages[j] = messages[i];
+			objects[j] = objects[i];
+			startTimes[j] = startTimes[i];
+			invDurations[j] = invDurations[i];
+			interps[j] = interps[i];
+			flags[j] = flags[i];
+			headings[j] = headings[i];
+			for(int c = 0; c < numVals; c++){
+				startVals[c][j] = startVals[c][i];
+				endVals[c][j] = endVals[c][i];
+			}
+			messages[j]->trackIndex = j;
+		}
+		j++;
+	}
+
+	messages.resize(j);
+	objects.resize(j);
+	startTimes.resize(j);
+	invDurations.resize(j);
+	interps.resize(j);
+	flags.resize(j);
+	times.resize(j);
+	eased.resize(j);
+	headings.resize(j);
+	for(int c = 0; c < numVals; c++){
+		startVals[c].resize(j);
+		endVals[c].resize(j);
+		outVals[c].resize(j);
+	}
+	numDead = 0;
+}
+
+
+//class ofxMessageTimeline _____________________________________________________________________________
+
+vector<ofxMessageTimeline *> ofxMessageTimeline::timelines;
+
+ofxMessageTimeline::ofxMessageTimeline()
+{
+	numScheduled = 0;
+	lastTime = 0;
+	nextListenerID = 0;
+	hasRemovedListeners = false;
+	isDispatching = false;
+	timelines.push_back(this);
+	for(int i = 0; i < OF_NUM_MESSAGE_TYPES; i++){
+		tracks[i].id = i;
+		tracks[i].numVals = ofxMessage::getNumVals(i);
+	}
+}
+
+ofxMessageTimeline::~ofxMessageTimeline()
+{
+	//let go of any messages that outlive the timeline
+	for(int i = 0; i < OF_NUM_MESSAGE_TYPES; i++){
+		for(int j = 0; j < tracks[i].size(); j++){
+			if(tracks[i].messages[j])
+				tracks[i].messages[j]->timeline = NULL;
+		}
+	}
+	for(unsigned int i = 0; i < pending.size(); i++){
+		pending[i].message->timeline = NULL;
+		pending[i].message->heapIndex = -1;
+	}
+	for(unsigned int i = 0; i < groups.size(); i++){
+		if(groups[i]) groups[i]->timeline = NULL;
+	}
+	releaseEvents(queuedEvents);
+	releaseEvents(events);
+	timelines.erase(find(timelines.begin(), timelines.end(), this));
+}
+
+//Adds iMessage for iObject. A message that's already on the timeline is restarted from its current settings.
+//New messages wait on the heap and join their tracks on the first update at or after their start time.
+void ofxMessageTimeline::add(ofxObject *iObject, ofxMessage *iMessage)
+{
+	if((iMessage->id < 0) || (iMessage->id >= OF_NUM_MESSAGE_TYPES)) return;
+
+	if(iMessage->timeline == this){
+		sync(iMessage);
+		return;
+	}
+	if(iMessage->timeline)
+		iMessage->timeline->remove(iMessage);
+
+	schedule(iObject, iMessage);
+}
+
+void ofxMessageTimeline::remove(ofxMessage *iMessage)
+{
+	if(iMessage->timeline != this) return;
+
+	if(iMessage->heapIndex >= 0)
+		unschedule(iMessage);
+	else
+		tracks[iMessage->id].kill(iMessage->trackIndex);
+}
+
+//Picks up changes made to a message's timing, easing or state after it was added.
+void ofxMessageTimeline::sync(ofxMessage *iMessage)
+{
+	if(iMessage->timeline != this) return;
+
+	float time = iMessage->startTime + iMessage->startDelay;
+	if(iMessage->heapIndex >= 0){
+		pending[iMessage->heapIndex].time = time;
+		siftUp(iMessage->heapIndex);
+		siftDown(iMessage->heapIndex);
+		return;
+	}
+
+	ofxMessageTracks &t = tracks[iMessage->id];
+	int i = iMessage->trackIndex;
+
+	//restarted with a start time still ahead, so it goes back to waiting
+	if(!iMessage->isRunning && (time > lastTime)){
+		ofxObject *object = t.objects[i];
+		t.kill(i);
+		schedule(object, iMessage);
+		return;
+	}
+
+	t.startTimes[i] = time;
+	t.invDurations[i] = (iMessage->duration > 0) ? 1.0f/iMessage->duration : FLT_MAX;
+	t.interps[i] = iMessage->interpolation;
+
+	unsigned char flag = t.flags[i] & OF_TRACK_RUNNING;
+	if(!iMessage->isRunning) flag = 0;
+	if(iMessage->isEnabled) flag |= OF_TRACK_ENABLED;
+	if(iMessage->loopDirection) flag |= OF_TRACK_REVERSED;
+	if(iMessage->path != OF_LINEAR_PATH) flag |= OF_TRACK_PATH;
+	if(iMessage->isOrientedToPath && (t.id == OF_TRANSLATE) && (iMessage->path != OF_LINEAR_PATH)) flag |= OF_TRACK_ORIENT;
+	t.flags[i] = flag;
+}
+
+int ofxMessageTimeline::getNumMessages()
+{
+	int num = 0;
+	for(int i = 0; i < OF_NUM_MESSAGE_TYPES; i++)
+		num += tracks[i].size() - tracks[i].numDead;
+
+	return num + (int)pending.size();
+}
+
+//Threads used to evaluate tracks, counting the one calling update(). Defaults to 1.
+void ofxMessageTimeline::setNumThreads(int iNumThreads)
+{
+	pool.setNumThreads(iNumThreads);
+}
+
+int ofxMessageTimeline::getNumThreads()
+{
+	return pool.getNumThreads();
+}
+
+int ofxMessageTimeline::getNumPendingMessages()
+{
+	return (int)pending.size();
+}
+
+void ofxMessageTimeline::update(float iTime)
+{
+	lastTime = iTime;
+	promote(iTime);
+
+	for(int i = 0; i < OF_NUM_MESSAGE_TYPES; i++){
+		if(tracks[i].size() == 0) continue;
+
+		evaluate(tracks[i], iTime);
+		scatter(tracks[i]);
+		finish(tracks[i], iTime);
+	}
+
+	//groups added or removed here take effect next update
+	unsigned int numGroups = groups.size();
+	for(unsigned int i = 0; i < numGroups; i++){
+		ofxGroupTween *group = groups[i];
+		if(!group || (iTime < group->startTime + group->startDelay)) continue;
+
+		if(group->update(iTime)){
+			groups[i] = NULL;
+			group->timeline = NULL;
+			if(group->autoDelete) delete group;
+		}
+	}
+
+	for(int i = 0; i < OF_NUM_MESSAGE_TYPES; i++)
+		tracks[i].compact();
+	groups.erase(std::remove(groups.begin(), groups.end(), (ofxGroupTween *)NULL), groups.end());
+
+	dispatch();
+	ofxTask::resumeReady();
+}
+
+//Resolves a message's relative start and end values against its object, the first frame it runs.
+//Show, hide and function messages fire here.
+void ofxMessageTimeline::start(ofxMessageTracks &iTracks, int iTrack)
+{
+	ofxMessage *message = iTracks.messages[iTrack];
+	ofxObject *object = iTracks.objects[iTrack];
+
+	iTracks.flags[iTrack] |= OF_TRACK_RUNNING;
+	message->isRunning = true;
+	emit(OF_MESSAGE_STARTED, iTracks, iTrack, lastTime);
+
+	ofVec4f cur;
+	ofVec3f v;
+	switch(iTracks.id){
+		case OF_TRANSLATE:
+			v = object->getTrans();
+			cur.set(v.x, v.y, v.z, 0);
+			break;
+		case OF_ROTATE:
+			v = object->getRot();
+			cur.set(v.x, v.y, v.z, 0);
+			break;
+		case OF_SCALE:
+		case OF_SCALE3:
+			v = object->getScale();
+			cur.set(v.x, v.y, v.z, 0);
+			break;
+		case OF_SETCOLOR:
+		case OF_SETCOLOR4:
+			cur = object->material->getColorVec4f();
+			break;
+		case OF_SETALPHA:
+			cur.x = object->material->getColorVec4f().w;
+			break;
+		case OF_SHOW:
+			object->show();
+			message->isEnabled = false;
+			return;
+		case OF_HIDE:
+			object->hide();
+			message->isEnabled = false;
+			return;
+		case OF_FUNCTION:
+			message->isEnabled = false;
+			message->functionPtr(message->functionArgs);
+			return;
+	}
+
+	for(int c = 0; c < iTracks.numVals; c++){
+		float s = message->baseStartVals[c];
+		float e = message->baseEndVals[c];
+		if(s == OF_RELATIVE_VAL) s = cur[c];
+		if(e == OF_RELATIVE_VAL) e = cur[c];
+
+		message->startVals[c] = iTracks.startVals[c][iTrack] = s;
+		message->endVals[c] = iTracks.endVals[c][iTrack] = e;
+	}
+}
+
+//Tracks starting this frame pick up their object's current values first. That, and any functions it fires,
+//happens here on the calling thread. The rest only writes each track's own slots, so it's split into
+//fixed blocks of tracks that can run on the pool in any order and still give the same results.
+void ofxMessageTimeline::evaluate(ofxMessageTracks &iTracks, float iTime)
+{
+	int n = iTracks.size();
+	for(int i = 0; i < n; i++){
+		if((iTracks.flags[i] & (OF_TRACK_ENABLED | OF_TRACK_RUNNING | OF_TRACK_DEAD)) == OF_TRACK_ENABLED && iTime >= iTracks.startTimes[i])
+			start(iTracks, i);
+	}
+
+	int numBlocks = (n + TRACK_BLOCK_SIZE - 1)/TRACK_BLOCK_SIZE;
+	pool.run(numBlocks, [&](int iBlock){
+		int begin = iBlock*TRACK_BLOCK_SIZE;
+		evaluateBlock(iTracks, begin, min(n, begin + TRACK_BLOCK_SIZE), iTime);
+	});
+}
+
+void ofxMessageTimeline::evaluateBlock(ofxMessageTracks &iTracks, int iBegin, int iEnd, float iTime)
+{
+	int n = iEnd - iBegin;
+	float *times = &iTracks.times[iBegin];
+	float *eased = &iTracks.eased[iBegin];
+	const float *startTimes = &iTracks.startTimes[iBegin];
+	const float *invDurations = &iTracks.invDurations[iBegin];
+	const int *interps = &iTracks.interps[iBegin];
+	const unsigned char *flags = &iTracks.flags[iBegin];
+
+	for(int i = 0; i < n; i++)
+		times[i] = (iTime - startTimes[i]) * invDurations[i];
+
+	ofxMessage::interpolateTimes(interps, times, eased, n);
+
+	//palindrome loops play their second half backwards
+	for(int i = 0; i < n; i++){
+		if(flags[i] & OF_TRACK_REVERSED)
+			eased[i] = 1.0f - eased[i];
+	}
+
+	for(int c = 0; c < iTracks.numVals; c++){
+		const float *s = &iTracks.startVals[c][iBegin];
+		const float *e = &iTracks.endVals[c][iBegin];
+		float *out = &iTracks.outVals[c][iBegin];
+		for(int i = 0; i < n; i++)
+			out[i] = (1.0f - eased[i])*s[i] + eased[i]*e[i];
+	}
+
+	for(int i = iBegin; i < iEnd; i++){
+		if((iTracks.flags[i] & OF_TRACK_PATH) && iTracks.isLive(i)){
+			ofxMessage *message = iTracks.messages[i];
+			float m = iTracks.eased[i];
+			ofVec4f p;
+			if(iTracks.flags[i] & OF_TRACK_ORIENT){
+				ofVec4f tangent;
+				p = message->pathCurve.evaluate(m, tangent);
+				//palindrome loops travel the path backwards on the way back
+				if(iTracks.flags[i] & OF_TRACK_REVERSED) tangent = tangent*-1;
+				if((tangent.x != 0) || (tangent.y != 0))
+					iTracks.headings[i] = atan2f(tangent.y, tangent.x)*RAD_TO_DEG;
+			}else
+				p = message->pathCurve.evaluate(m);
+
+			for(int c = 0; c < iTracks.numVals; c++)
+				iTracks.outVals[c][i] = p[c];
+		}
+	}
+}
+
+//Writes the evaluated values back to their objects.
+void ofxMessageTimeline::scatter(ofxMessageTracks &iTracks)
+{
+	int n = iTracks.size();
+	if(iTracks.numVals == 0) return;
+
+	const float *x = &iTracks.outVals[0][0];
+	const float *y = (iTracks.numVals > 1) ? &iTracks.outVals[1][0] : NULL;
+	const float *z = (iTracks.numVals > 2) ? &iTracks.outVals[2][0] : NULL;
+	const float *w = (iTracks.numVals > 3) ? &iTracks.outVals[3][0] : NULL;
+
+	for(int i = 0; i < n; i++){
+		if(!iTracks.isLive(i)) continue;
+
+		ofxObject *object = iTracks.objects[i];
+		switch(iTracks.id){
+			case OF_TRANSLATE:
+				object->setTrans(x[i], y[i], z[i]);
+				if(iTracks.flags[i] & OF_TRACK_ORIENT){
+					ofVec3f rot = object->getRot();
+					object->setRot(rot.x, rot.y, iTracks.headings[i]);
+				}
+				break;
+			case OF_ROTATE:
+				object->setRot(x[i], y[i], z[i]);
+				break;
+			case OF_SCALE:
+				object->setScale(x[i]);
+				break;
+			case OF_SCALE3:
+				object->setScale(x[i], y[i], z[i]);
+				break;
+			case OF_SETCOLOR:
+				object->setColor(x[i], y[i], z[i]);
+				break;
+			case OF_SETCOLOR4:
+				object->setColor(x[i], y[i], z[i], w[i]);
+				break;
+			case OF_SETALPHA:
+				object->setAlpha(x[i]);
+				break;
+		}
+	}
+}
+
+//Loops finished messages or takes them off the timeline, deleting the ones marked autoDelete.
+void ofxMessageTimeline::finish(ofxMessageTracks &iTracks, float iTime)
+{
+	int n = iTracks.size();
+	for(int i = 0; i < n; i++){
+		if((iTracks.times[i] < 1.0f) || !iTracks.isLive(i)) continue;
+
+		ofxMessage *message = iTracks.messages[i];
+		if((message->playMode == OF_LOOP_PLAY) || (message->playMode == OF_LOOP_PALINDROME_PLAY)){
+			if(message->playMode == OF_LOOP_PALINDROME_PLAY){
+				message->loopDirection = !message->loopDirection;
+				iTracks.flags[i] ^= OF_TRACK_REVERSED;
+			}
+			message->isEnabled = true;
+			message->isRunning = false;
+			message->startTime = iTime;
+			iTracks.startTimes[i] = iTime + message->startDelay;
+			iTracks.flags[i] = (iTracks.flags[i] & ~OF_TRACK_RUNNING) | OF_TRACK_ENABLED;
+			emit(OF_MESSAGE_LOOPED, iTracks, i, iTime);
+		}else{
+			ofxObject *object = iTracks.objects[i];
+			message->isEnabled = false;
+			message->isRunning = false;
+			emit(OF_MESSAGE_COMPLETED, iTracks, i, iTime);
+			ofxTask::messageFinished(message);
+			iTracks.kill(i);
+
+			if(message->autoDelete)
+				object->deleteMessage(message);
+		}
+	}
+}
+
+
+//pending heap _____________________________________________________________________________
+
+void ofxMessageTimeline::schedule(ofxObject *iObject, ofxMessage *iMessage)
+{
+	ofxPendingMessage entry;
+	entry.time = iMessage->startTime + iMessage->startDelay;
+	entry.order = numScheduled++;
+	entry.message = iMessage;
+	entry.object = iObject;
+
+	iMessage->timeline = this;
+	iMessage->heapIndex = (int)pending.size();
+	pending.push_back(entry);
+	siftUp(iMessage->heapIndex);
+}
+
+void ofxMessageTimeline::unschedule(ofxMessage *iMessage)
+{
+	int i = iMessage->heapIndex;
+	int last = (int)pending.size() - 1;
+
+	swapPending(i, last);
+	pending.pop_back();
+	iMessage->heapIndex = -1;
+	iMessage->timeline = NULL;
+
+	if(i < last){
+		siftUp(i);
+		siftDown(i);
+	}
+}
+
+//Moves messages that are due onto their tracks, earliest first.
+void ofxMessageTimeline::promote(float iTime)
+{
+	while(!pending.empty() && (pending[0].time <= iTime)){
+		ofxMessage *message = pending[0].message;
+		ofxObject *object = pending[0].object;
+		unschedule(message);
+
+		message->timeline = this;
+		message->trackIndex = tracks[message->id].add(object, message);
+	}
+}
+
+bool ofxMessageTimeline::isEarlier(int iA, int iB)
+{
+	if(pending[iA].time != pending[iB].time)
+		return pending[iA].time < pending[iB].time;
+
+	return pending[iA].order < pending[iB].order;
+}
+
+void ofxMessageTimeline::swapPending(int iA, int iB)
+{
+	ofxPendingMessage tmp = pending[iA];
+	pending[iA] = pending[iB];
+	pending[iB] = tmp;
+	pending[iA].message->heapIndex = iA;
+	pending[iB].message->heapIndex = iB;
+}
+
+void ofxMessageTimeline::siftUp(int iIndex)
+{
+	while(iIndex > 0){
+		int parent = (iIndex - 1)/2;
+		if(!isEarlier(iIndex, parent)) break;
+		swapPending(iIndex, parent);
+		iIndex = parent;
+	}
+}
+
+void ofxMessageTimeline::siftDown(int iIndex)
+{
+	int n = (int)pending.size();
+	while(true){
+		int child = 2*iIndex + 1;
+		if(child >= n) break;
+		if((child + 1 < n) && isEarlier(child + 1, child)) child++;
+		if(!isEarlier(child, iIndex)) break;
+		swapPending(iIndex, child);
+		iIndex = child;
+	}
+}
+
+
+//groups _____________________________________________________________________________
+
+void ofxMessageTimeline::addGroup(ofxGroupTween *iGroup)
+{
+	if(iGroup->timeline == this) return;
+	if(iGroup->timeline) iGroup->timeline->removeGroup(iGroup);
+
+	iGroup->timeline = this;
+	groups.push_back(iGroup);
+}
+
+//Takes the group off the timeline without deleting it.
+void ofxMessageTimeline::removeGroup(ofxGroupTween *iGroup)
+{
+	if(iGroup->timeline != this) return;
+
+	vector<ofxGroupTween *>::iterator it = find(groups.begin(), groups.end(), iGroup);
+	if(it != groups.end()) *it = NULL;
+	iGroup->timeline = NULL;
+}
+
+//Runs iTask's first steps at the end of the next update.
+void ofxMessageTimeline::addTask(ofxTask *iTask)
+{
+	iTask->timeline = this;
+	iTask->running = true;
+	iTask->wake();
+}
+
+int ofxMessageTimeline::getNumGroups()
+{
+	return (int)(groups.size() - count(groups.begin(), groups.end(), (ofxGroupTween *)NULL));
+}
+
+
+//events _____________________________________________________________________________
+
+//iListener is called with the events matching iMask at the end of every update. Returns an id for removeListener().
+//Listeners added while events are being handed out start with the next update.
+int ofxMessageTimeline::addListener(const ofxMessageListener &iListener, int iMask)
+{
+	ofxMessageListenerEntry entry;
+	entry.id = nextListenerID++;
+	entry.mask = iMask;
+	entry.isRemoved = false;
+	entry.callback = iListener;
+
+	if(isDispatching) addedListeners.push_back(entry);
+	else listeners.push_back(entry);
+
+	return entry.id;
+}
+
+//Safe to call from a listener, even on itself. It's erased once the events have been handed out.
+void ofxMessageTimeline::removeListener(int iID)
+{
+	for(unsigned int i = 0; i < listeners.size(); i++){
+		if(listeners[i].id == iID) listeners[i].isRemoved = true;
+	}
+	for(unsigned int i = 0; i < addedListeners.size(); i++){
+		if(addedListeners[i].id == iID) addedListeners[i].isRemoved = true;
+	}
+	hasRemovedListeners = true;
+	if(!isDispatching) eraseRemovedListeners();
+}
+
+void ofxMessageTimeline::eraseRemovedListeners()
+{
+	for(unsigned int i = 0; i < addedListeners.size(); i++){
+		if(!addedListeners[i].isRemoved) listeners.push_back(addedListeners[i]);
+	}
+	addedListeners.clear();
+
+	if(!hasRemovedListeners) return;
+
+	unsigned int k = 0;
+	for(unsigned int i = 0; i < listeners.size(); i++){
+		if(!listeners[i].isRemoved){
+			if(k != i) listeners[k] = listeners[i];
+			k++;
+		}
+	}
+	listeners.resize(k);
+	hasRemovedListeners = false;
+}
+
+//Nothing is queued without listeners, so messages and objects can be deleted without touching the events.
+void ofxMessageTimeline::emit(int iType, ofxMessageTracks &iTracks, int iTrack, float iTime)
+{
+	if(listeners.empty() && addedListeners.empty()) return;
+
+	ofxMessageEvent event;
+	event.type = iType;
+	event.messageID = iTracks.id;
+	event.message = iTracks.messages[iTrack];
+	event.handle = event.message->getHandle();
+	event.object = iTracks.objects[iTrack];
+	event.time = iTime;
+	event.object->numEvents++;
+	queuedEvents.push_back(event);
+}
+
+//Hands this update's events to the listeners, in the order they happened.
+void ofxMessageTimeline::dispatch()
+{
+	releaseEvents(events);
+	events.swap(queuedEvents);
+	queuedEvents.clear();
+	if(events.empty() || listeners.empty()) return;
+
+	isDispatching = true;
+
+	for(unsigned int i = 0; i < events.size(); i++){
+		for(unsigned int j = 0; j < listeners.size(); j++){
+			//the object may have been deleted by an earlier listener
+			if(!events[i].object) break;
+			if(listeners[j].isRemoved || !(listeners[j].mask & events[i].type)) continue;
+
+			//so may the message, by this or an earlier listener
+			ofxMessageEvent event = events[i];
+			event.message = event.handle.get();
+			listeners[j].callback(event);
+		}
+		events[i].message = events[i].handle.get();
+	}
+
+	isDispatching = false;
+	eraseRemovedListeners();
+}
+
+//Events for deleted objects are skipped, and deleted objects drop out of their groups.
+//Only objects named by events still held by a timeline need them searched.
+void ofxMessageTimeline::forgetObject(ofxObject *iObject)
+{
+	while(!iObject->groupTweens.empty())
+		iObject->groupTweens.back()->removeObject(iObject);
+
+	for(unsigned int t = 0; (t < timelines.size()) && (iObject->numEvents > 0); t++){
+		forgetEvents(timelines[t]->queuedEvents, iObject);
+		forgetEvents(timelines[t]->events, iObject);
+	}
+}
+
+//Drops the events' claims on their objects before the events are discarded.
+void ofxMessageTimeline::releaseEvents(vector<ofxMessageEvent> &ioEvents)
+{
+	for(unsigned int i = 0; i < ioEvents.size(); i++){
+		if(ioEvents[i].object) ioEvents[i].object->numEvents--;
+	}
+}
+
+//Clears the object and message of iObject's events.
+void ofxMessageTimeline::forgetEvents(vector<ofxMessageEvent> &ioEvents, ofxObject *iObject)
+{
+	for(unsigned int i = 0; i < ioEvents.size(); i++){
+		if(ioEvents[i].object == iObject){
+			ioEvents[i].object = NULL;
+			ioEvents[i].message = NULL;
+			ioEvents[i].handle = ofxMessageHandle();
+			iObject->numEvents--;
+		}
+	}
+}
@@ -0,0 +1,191 @@
+/*
+ofxMessageTimeline
+
+Evaluates the messages of every object in a scene in one pass. Messages are stored as tracks grouped
+by message type, with times, easing and values laid out in flat arrays, so interpolation for thousands of
+tweens runs as tight loops before the results are written back to their objects.
+Objects still keep their own message lists (see ofxObject::doMessage()), the timeline just does the work.
+Each ofxScene owns one, and hands it to its objects while it updates them.
+Messages that haven't started yet wait in a min-heap keyed on their start time, and only join the tracks
+when they're due, so cues scheduled far ahead cost nothing per frame.
+With setNumThreads(), the easing and interpolation of large track groups is spread over a thread pool.
+Starting messages, function calls and writing values back to objects always happen on the updating thread,
+so results are the same for any number of threads.
+Group tweens (see ofxGroupTween) each take a single entry, however many objects they move.
+Tasks (see ofxTask) waiting on it are resumed at the end of each update.
+Messages starting, looping and completing are queued as events, and handed to listeners (see addListener())
+together at the end of each update, so nothing has to poll objects to find out when their tweens finish.
+Events are only queued while the timeline has listeners. An event's object is set to NULL if it's deleted before
+the event is handed out, or later. Its message is checked as the event is handed out; use its handle after that.
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF 
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "ofxMessage.h"
+#include "ofxSosoThreadPool.h"
+#include "ofxGroupTween.h"
+#include <functional>
+
+class ofxObject;
+class ofxTask;
+
+enum{
+	OF_TRACK_ENABLED = 0x01,
+	OF_TRACK_RUNNING = 0x02,
+	OF_TRACK_REVERSED = 0x04,
+	OF_TRACK_PATH = 0x08,
+	OF_TRACK_DEAD = 0x10,
+	OF_TRACK_ORIENT = 0x20
+};
+
+enum{
+	OF_MESSAGE_STARTED = 0x01,				//also at the start of every loop
+	OF_MESSAGE_LOOPED = 0x02,
+	OF_MESSAGE_COMPLETED = 0x04,
+	OF_MESSAGE_ALL_EVENTS = 0x07
+};
+
+//Something that happened to a message during an update.
+struct ofxMessageEvent
+{
+	int								type;
+	int								messageID;		//OF_TRANSLATE, OF_SETALPHA, ...
+	ofxMessage						*message;		//NULL if deleted before the event was handed out, e.g. autoDelete messages on completion
+	ofxMessageHandle				handle;
+	ofxObject						*object;		//NULL once deleted
+	float							time;
+};
+
+typedef std::function<void(const ofxMessageEvent &)> ofxMessageListener;
+
+struct ofxMessageListenerEntry
+{
+	int								id;
+	int								mask;
+	bool							isRemoved;
+	ofxMessageListener				callback;
+};
+
+//All tracks of one message type, stored component-major.
+class ofxMessageTracks
+{
+public:
+	ofxMessageTracks();
+
+	int								add(ofxObject *iObject, ofxMessage *iMessage);
+	void							kill(int iTrack);
+	void							compact();
+	int								size(){ return (int)messages.size(); }
+	bool							isLive(int iTrack){ return (flags[iTrack] & (OF_TRACK_ENABLED | OF_TRACK_RUNNING | OF_TRACK_DEAD)) == (OF_TRACK_ENABLED | OF_TRACK_RUNNING); }
+
+public:
+	int								id;
+	int								numVals;
+	int								numDead;
+	vector<ofxMessage *>			messages;
+	vector<ofxObject *>				objects;
+	vector<float>					startTimes;			//startTime + startDelay
+	vector<float>					invDurations;
+	vector<int>						interps;
+	vector<unsigned char>			flags;
+	vector<float>					times;				//normalized time, per frame
+	vector<float>					eased;				//eased time, per frame
+	vector<float>					startVals[4];
+	vector<float>					endVals[4];
+	vector<float>					outVals[4];
+	vector<float>					headings;			//z rotation for tracks oriented to their path
+};
+
+//A message waiting on the timeline's heap for its start time.
+struct ofxPendingMessage
+{
+	float							time;
+	unsigned int					order;			//breaks ties in the order messages were added
+	ofxMessage						*message;
+	ofxObject						*object;
+};
+
+class ofxMessageTimeline
+{
+public:
+	ofxMessageTimeline();
+	~ofxMessageTimeline();
+
+	void							add(ofxObject *iObject, ofxMessage *iMessage);
+	void							remove(ofxMessage *iMessage);
+	void							sync(ofxMessage *iMessage);
+	void							update(float iTime);
+	int								getNumMessages();
+	int								getNumPendingMessages();
+	void							setNumThreads(int iNumThreads);
+	int								getNumThreads();
+
+	int								addListener(const ofxMessageListener &iListener, int iMask=OF_MESSAGE_ALL_EVENTS);
+	void							removeListener(int iID);
+	const vector<ofxMessageEvent>&	getEvents(){ return events; }
+
+	void							addGroup(ofxGroupTween *iGroup);
+	void							removeGroup(ofxGroupTween *iGroup);
+	int								getNumGroups();
+	void							addTask(ofxTask *iTask);
+
+	static void						forgetObject(ofxObject *iObject);
+
+protected:
+	void							schedule(ofxObject *iObject, ofxMessage *iMessage);
+	void							unschedule(ofxMessage *iMessage);
+	void							promote(float iTime);
+	bool							isEarlier(int iA, int iB);
+	void							swapPending(int iA, int iB);
+	void							siftUp(int iIndex);
+	void							siftDown(int iIndex);
+
+	void							start(ofxMessageTracks &iTracks, int iTrack);
+	void							evaluate(ofxMessageTracks &iTracks, float iTime);
+	void							evaluateBlock(ofxMessageTracks &iTracks, int iBegin, int iEnd, float iTime);
+	void							scatter(ofxMessageTracks &iTracks);
+	void							finish(ofxMessageTracks &iTracks, float iTime);
+	void							emit(int iType, ofxMessageTracks &iTracks, int iTrack, float iTime);
+	void							dispatch();
+	void							eraseRemovedListeners();
+	static void						releaseEvents(vector<ofxMessageEvent> &ioEvents);
+	static void						forgetEvents(vector<ofxMessageEvent> &ioEvents, ofxObject *iObject);
+
+public:
+	ofxMessageTracks				tracks[OF_NUM_MESSAGE_TYPES];
+
+protected:
+	vector<ofxPendingMessage>		pending;		//binary min-heap on time
+	unsigned int					numScheduled;
+	float							lastTime;
+	ofxSosoThreadPool				pool;
+
+	vector<ofxMessageEvent>			queuedEvents;
+	vector<ofxMessageEvent>			events;			//the last update's
+	vector<ofxMessageListenerEntry>	listeners;
+	vector<ofxMessageListenerEntry>	addedListeners;		//while dispatching
+	int								nextListenerID;
+	bool							hasRemovedListeners;
+	bool							isDispatching;
+
+	vector<ofxGroupTween *>			groups;			//NULL where a group was removed, until the next update
+
+	static vector<ofxMessageTimeline *>	timelines;
+};
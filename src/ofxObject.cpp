@@ -1,6 +1,7 @@
 #include "ofxObject.h"
 #include "ofUtils.h"
 #include "ofAppRunner.h"	//for ofGetLastFrameTime()
+#include "ofxClock.h"
 
 
 //class ofxObjectMaterial _____________________________________________________________________________
@@ -27,7 +28,14 @@ ofVec4f ofxObjectMaterial::getColorVec4f(){
 int ofxObject::numObjects = 0;
 bool ofxObject::alwaysMatrixDirty = false;
 bool ofxObject::prevLit = true;
+void (*ofxObject::batchFlushFunc)() = NULL;
 float ofxObject::curTime = 0;	//Updated by ofxScene
+ofxMessageTimeline *ofxObject::curTimeline = NULL;	//Set by ofxScene while it updates
+
+//runs the messages of objects that are idled outside of a scene
+static ofxMessageTimeline *defaultTimeline = NULL;
+float ofxObject::curProjection[16] = {1,0,0,0, 0,1,0,0, 0,0,1,0, 0,0,0,1};	//Updated by ofxScene
+float ofxObject::curViewportHeight = 0;	//Updated by ofxScene, 0 until a scene has been drawn
 
 ofxObject::ofxObject(){
   
@@ -65,9 +73,14 @@ ofxObject::ofxObject(){
 	isSortedObject = false;
 	sortedObjectsWindowZ = 0;
 	
-	timePrev = ofGetElapsedTimef();	//ofGetSystemTime()/1000.0f;
+	timePrev = ofxClock::getCurrentTime();	//ofGetSystemTime()/1000.0f;
 	timeElapsed = 0;
   
+  hasUnscheduledMessages = false;
+  numEvents = 0;
+  for(int i=0; i < OF_NUM_MESSAGE_TYPES; i++)
+    messageSlots[i] = NULL;
+  
   //shader info
   shader = new ofShader();
   shaderEnabled = true; // Enabled by default
@@ -76,14 +89,15 @@ ofxObject::ofxObject(){
 // Destructor.
 ofxObject::~ofxObject()
 {
+  //Drops any events for this object still waiting to be handed out this frame.
+  ofxMessageTimeline::forgetObject(this);
   
   // 1 --- Destroy new'ed items.
   delete material;
 	delete drawMaterial;
-  for (auto message : messages){
-    delete message;
-  }
-  messages.clear();
+  //each message takes itself off the list as it's deleted
+  while(!messages.empty())
+    delete messages.back();
   
   // 2 --- Destroy other items.
   for (auto parent : parents){
@@ -274,6 +288,17 @@ void ofxObject::enableAlphaInheritance(bool iEnable)
 
 void ofxObject::idleBase(float iTime)
 {
+  //not part of a scene update, so this subtree's messages go on the default timeline
+  if(curTimeline == NULL){
+    if(defaultTimeline == NULL)
+      defaultTimeline = new ofxMessageTimeline();
+    curTimeline = defaultTimeline;
+    idleBase(iTime);
+    defaultTimeline->update(curTime);
+    curTimeline = NULL;
+    return;
+  }
+  
 	//timeElapsed = ofGetElapsedTimef() - timePrev; //ofGetSystemTime()/1000.0f - timePrev;
 	//timePrev = ofGetElapsedTimef();	//ofGetSystemTime()/1000.0f;
   
@@ -316,6 +341,8 @@ void ofxObject::draw(ofxObjectMaterial *iMaterial, float *iMatrix, int iSelect,
 			float *mat = updateMatrix(iMatrix);
 			ofxObjectMaterial *m = updateMaterial(iMaterial);	//v4.0
       
+			//queued geometry has to go out before anything else draws or lighting changes
+			if(!isBatchable() || (isLit != prevLit)) flushBatch();
 			predraw();
       
 			if ((iSelect == OF_RENDER_TRANSPARENT) && !hasTransparency()) {
@@ -340,6 +367,7 @@ void ofxObject::draw(ofxObjectMaterial *iMaterial, float *iMatrix, int iSelect,
 			//iDrawAlone is true  just draw this object (no children)
 			//PEND idle of children won't get called for these objects! live with it or fix it
 			//v4.0 (moving children draw loop above might have fixed it)
+			if(!isBatchable() || (isLit != prevLit)) flushBatch();
 			predraw();
 			render();
 			postdraw();
@@ -425,6 +453,9 @@ void ofxObject::postdraw()
 	//ofPopMatrix();
 	glPopName();
   
+  //children may have queued geometry that needs this object's shader
+  if (shaderEnabled && (shader != NULL)) flushBatch();
+  
   // End shader if there is one
   if (shaderEnabled){
     if (shader!=NULL){
@@ -501,6 +532,25 @@ ofVec3f ofxObject::getWindowCoords()
 	return ofVec3f(wx, wy, wz);
 }
 
+// Returns how many pixels one unit of this object's local space covers on screen,
+// based on its world matrix and the projection of the scene drawing it.
+// Returns -1 if no scene has set up a projection yet, 0 if the object is behind the camera.
+// Cheap enough to call from render(), unlike getWindowCoords() it doesn't query GL.
+float ofxObject::getPixelsPerUnit()
+{
+	if (curViewportHeight <= 0) return -1;
+  
+	//largest scale of the local x and y axes
+	float sx = sqrtf(matrix[0]*matrix[0] + matrix[1]*matrix[1] + matrix[2]*matrix[2]);
+	float sy = sqrtf(matrix[4]*matrix[4] + matrix[5]*matrix[5] + matrix[6]*matrix[6]);
+  
+	//clip space w of the object's origin (eye space distance for perspective, 1 for ortho)
+	float w = curProjection[3]*matrix[12] + curProjection[7]*matrix[13] + curProjection[11]*matrix[14] + curProjection[15];
+	if (w <= 0.0001f) return 0;
+  
+	return MAX(sx, sy) * curProjection[5] * 0.5f * curViewportHeight / w;
+}
+
 float* ofxObject::getMatrix()
 {
 	return (float *)matrix;
@@ -874,399 +924,69 @@ void ofxObject::LoadIdentity(float *dest)
 	dest[15] = 1;
 }
 
+// Draws whatever batching objects (eg ofxRectangleObject) have queued so far.
+// Called by ofxObject::draw() before other objects render, and by ofxScene at the end of each pass.
+void ofxObject::flushBatch()
+{
+	if (batchFlushFunc) {
+		void (*flush)() = batchFlushFunc;
+		batchFlushFunc = NULL;
+		flush();
+	}
+}
+
+// Called by batching objects before queueing geometry for iFlushFunc. Another kind of batch that's
+// still pending is drawn first, so everything comes out in order.
+void ofxObject::queueBatch(void (*iFlushFunc)())
+{
+	if (batchFlushFunc != iFlushFunc) flushBatch();
+	batchFlushFunc = iFlushFunc;
+}
+
+// Called by ofxScene before drawing, so objects can work out their size on screen.
+void ofxObject::setProjection(float *iProjectionMatrix, float iViewportHeight)
+{
+	for (int i = 0; i < 16; i++)
+		curProjection[i] = iProjectionMatrix[i];
+	curViewportHeight = iViewportHeight;
+}
+
+// Number of segments a full circle needs so that its chords stray no more than iTolerance pixels
+// from a true circle of iPixelRadius pixels. Rounded up to a multiple of 4 and clamped to [iMinRes, iMaxRes].
+int ofxObject::getCurveResolution(float iPixelRadius, float iTolerance, int iMinRes, int iMaxRes)
+{
+	if (iMaxRes < iMinRes) iMaxRes = iMinRes;
+	if (iPixelRadius <= iTolerance) return iMinRes;
+  
+	int res = (int)ceil(PI / acos(1.0 - iTolerance/iPixelRadius));
+	res = (res + 3) & ~3;
+  
+	return (int)ofClamp(res, iMinRes, iMaxRes);
+}
+
 
 
+//Messages are evaluated for all objects at once by the scene's timeline (see ofxMessageTimeline).
+//This only hands over messages that were added while no timeline was active.
 void ofxObject::updateMessages()
 {
+	if(!hasUnscheduledMessages || (curTimeline == NULL)) return;
+  
 	for(unsigned int i=0; i < messages.size(); i++){
-		if(messages[i]->isEnabled){
-      
-			//grab commonly needed values
-			float startTime = messages[i]->startTime + messages[i]->startDelay;
-			float endTime = messages[i]->getFinishTime();
-			float duration = messages[i]->duration;
-			float time = ofxMessage::interpolateTime(messages[i]->interpolation, (curTime - startTime)/duration);
-			float t = time;
-			float x,y,z,w;
-			//printf("t_%02d = %f\n", i, t);
-      
-			//adjust t for palindrome looping
-			if(messages[i]->playMode == OF_LOOP_PALINDROME_PLAY){
-				if(messages[i]->loopDirection) t = 1.0 - time;
-			}
-      
-			//translation__________________________________________________________
-			if(messages[i]->id == OF_TRANSLATE){
-				if(curTime >= startTime){
-					if(!messages[i]->isRunning){
-						//set start values once
-						ofVec3f *vec = (ofVec3f *)messages[i]->baseStartVals;
-						if(vec){
-							if(vec->x == OF_RELATIVE_VAL) x = xyz.x;
-							else x = vec->x;
-							if(vec->y == OF_RELATIVE_VAL) y = xyz.y;
-							else y = vec->y;
-							if(vec->z == OF_RELATIVE_VAL) z = xyz.z;
-							else z = vec->z;
-              
-							messages[i]->setStartVals(x,y,z);
-							//printf("message start vals = %f, %f, %f\n", x,y,z);
-						}
-            
-						//set end values once
-						ofVec3f *vecEnd = (ofVec3f *)messages[i]->baseEndVals;
-						if(vecEnd){
-							if(vecEnd->x == OF_RELATIVE_VAL) x = xyz.x;
-							else x = vecEnd->x;
-							if(vecEnd->y == OF_RELATIVE_VAL) y = xyz.y;
-							else y = vecEnd->y;
-							if(vecEnd->z == OF_RELATIVE_VAL) z = xyz.z;
-							else z = vecEnd->z;
-              
-							messages[i]->setEndVals(x,y,z);
-							//printf("message end vals = %f, %f, %f\n", x,y,z);
-						}
-            
-						/*
-             printf("translate start Vals = %f, %f, %f\n", x,y,z);
-             printf("translate end Vals = %f, %f, %f\n",
-             ((ofVec3f *)messages[i]->vals)->x,
-             ((ofVec3f *)messages[i]->vals)->y,
-             ((ofVec3f *)messages[i]->vals)->z);
-             */
-            
-						messages[i]->isRunning = true;
-					}
-					//update value
-					if(messages[i]->path == OF_LINEAR_PATH){
-						setTrans((1-t)*((ofVec3f *)messages[i]->startVals)->x + t*((ofVec3f *)messages[i]->endVals)->x,
-                     (1-t)*((ofVec3f *)messages[i]->startVals)->y + t*((ofVec3f *)messages[i]->endVals)->y,
-                     (1-t)*((ofVec3f *)messages[i]->startVals)->z + t*((ofVec3f *)messages[i]->endVals)->z);
-					}else if(messages[i]->path == OF_BEZIER_PATH){
-						ofVec4f trans = ofxMessage::bezier(t, messages[i]->pathPoints);
-						setTrans(trans.x, trans.y, trans.z);
-					}else if(messages[i]->path == OF_SPLINE_PATH){
-						ofVec4f trans = ofxMessage::spline(t, messages[i]->pathPoints);
-						setTrans(trans.x, trans.y, trans.z);
-					}
-          
-				}
-			}
-			//rotation_____________________________________________________________
-			else if(messages[i]->id == OF_ROTATE){
-				if(curTime >= startTime){
-					if(!messages[i]->isRunning){
-						//set start values once
-						ofVec3f *vec = (ofVec3f *)messages[i]->baseStartVals;
-						if(vec){
-							if(vec->x == OF_RELATIVE_VAL) x = xyzRot.x;
-							else x = vec->x;
-							if(vec->y == OF_RELATIVE_VAL) y = xyzRot.y;
-							else y = vec->y;
-							if(vec->z == OF_RELATIVE_VAL) z = xyzRot.z;
-							else z = vec->z;
-              
-							messages[i]->setStartVals(x, y, z);
-						}
-            
-						//set end values once
-						ofVec3f *vecEnd = (ofVec3f *)messages[i]->baseEndVals;
-						if(vecEnd){
-							if(vecEnd->x == OF_RELATIVE_VAL) x = xyzRot.x;
-							else x = vecEnd->x;
-							if(vecEnd->y == OF_RELATIVE_VAL) y = xyzRot.y;
-							else y = vecEnd->y;
-							if(vecEnd->z == OF_RELATIVE_VAL) z = xyzRot.z;
-							else z = vecEnd->z;
-              
-							messages[i]->setEndVals(x,y,z);
-						}
-            
-						messages[i]->isRunning = true;
-					}
-					//update value
-					if(messages[i]->path == OF_LINEAR_PATH){
-						setRot((1-t)*((ofVec3f *)messages[i]->startVals)->x + t*((ofVec3f *)messages[i]->endVals)->x,
-                   (1-t)*((ofVec3f *)messages[i]->startVals)->y + t*((ofVec3f *)messages[i]->endVals)->y,
-                   (1-t)*((ofVec3f *)messages[i]->startVals)->z + t*((ofVec3f *)messages[i]->endVals)->z);
-					}else if(messages[i]->path == OF_BEZIER_PATH){
-						ofVec4f rot = ofxMessage::bezier(t, messages[i]->pathPoints);
-						setRot(rot.x, rot.y, rot.z);
-					}else if(messages[i]->path == OF_SPLINE_PATH){
-						ofVec4f rot = ofxMessage::spline(t, messages[i]->pathPoints);
-						setRot(rot.x, rot.y, rot.z);
-					}
-				}
-			}
-			//scaling_______________________________________________________________
-			else if(messages[i]->id == OF_SCALE){
-				//printf("startTime = %f\n", startTime);
-				if(curTime >= startTime){
-					//printf("doing message %f\n", curTime);
-					if(!messages[i]->isRunning){
-						//set start values once
-						float *v = (float *)messages[i]->baseStartVals;
-						if(v){
-							if(v[0] == OF_RELATIVE_VAL) x = scale.x;
-							else x = v[0];
-              
-							messages[i]->setStartVals(x);
-						}
-            
-						//set end values once
-						float *vEnd = (float *)messages[i]->baseEndVals;
-						if(vEnd){
-							if(vEnd[0] == OF_RELATIVE_VAL) x = scale.x;
-							else x = vEnd[0];
-              
-							messages[i]->setEndVals(x);
-						}
-            
-						messages[i]->isRunning = true;
-					}
-					//update value
-					if(messages[i]->path == OF_LINEAR_PATH){
-						setScale((1-t)*((float *)messages[i]->startVals)[0] + t*((float *)messages[i]->endVals)[0]);
-					}else if(messages[i]->path == OF_BEZIER_PATH){
-						ofVec4f s = ofxMessage::bezier(t, messages[i]->pathPoints);
-						setScale(s.x);
-					}else if(messages[i]->path == OF_SPLINE_PATH){
-						ofVec4f s = ofxMessage::spline(t, messages[i]->pathPoints);
-						setScale(s.x);
-					}
-				}
-			}
-			//scaling in 3 dimensions differently ___________________________________
-			else if(messages[i]->id == OF_SCALE3){
-				if(curTime >= startTime){
-					if(!messages[i]->isRunning){
-						//set start avlues once
-						ofVec3f *vec = (ofVec3f *)messages[i]->baseStartVals;
-						if(vec){
-							if(vec->x == OF_RELATIVE_VAL) x = scale.x;
-							else x = vec->x;
-							if(vec->y == OF_RELATIVE_VAL) y = scale.y;
-							else y = vec->y;
-							if(vec->z == OF_RELATIVE_VAL) z = scale.z;
-							else z = vec->z;
-              
-							messages[i]->setStartVals(x, y, z);
-						}
-            
-						//set end values once
-						ofVec3f *vecEnd = (ofVec3f *)messages[i]->baseEndVals;
-						if(vecEnd){
-							if(vecEnd->x == OF_RELATIVE_VAL) x = scale.x;
-							else x = vecEnd->x;
-							if(vecEnd->y == OF_RELATIVE_VAL) y = scale.y;
-							else y = vecEnd->y;
-							if(vecEnd->z == OF_RELATIVE_VAL) z = scale.z;
-							else z = vecEnd->z;
-              
-							messages[i]->setEndVals(x,y,z);
-						}
-            
-						messages[i]->isRunning = true;
-					}
-					//update value
-					if(messages[i]->path == OF_LINEAR_PATH){
-						setScale((1-t)*((ofVec3f *)messages[i]->startVals)->x + t*((ofVec3f *)messages[i]->endVals)->x,
-                     (1-t)*((ofVec3f *)messages[i]->startVals)->y + t*((ofVec3f *)messages[i]->endVals)->y,
-                     (1-t)*((ofVec3f *)messages[i]->startVals)->z + t*((ofVec3f *)messages[i]->endVals)->z);
-					}else if(messages[i]->path == OF_BEZIER_PATH){
-						ofVec4f s = ofxMessage::bezier(t, messages[i]->pathPoints);
-						setScale(s.x, s.y, s.z);
-					}else if(messages[i]->path == OF_SPLINE_PATH){
-						ofVec4f s = ofxMessage::spline(t, messages[i]->pathPoints);
-						setScale(s.x, s.y, s.z);
-					}
-				}
-			}
-			//color _________________________________________________________________
-			else if(messages[i]->id == OF_SETCOLOR){
-				if(curTime >= startTime){
-					if(!messages[i]->isRunning){
-						//set start values once
-						ofVec3f *vec = (ofVec3f *)messages[i]->baseStartVals;
-						if(vec){
-							if(vec->x == OF_RELATIVE_VAL) x = material->getColorVec4f().x;
-							else x = vec->x;
-							if(vec->y == OF_RELATIVE_VAL) y = material->getColorVec4f().y;
-							else y = vec->y;
-							if(vec->z == OF_RELATIVE_VAL) z = material->getColorVec4f().z;
-							else z = vec->z;
-              
-							messages[i]->setStartVals(x, y, z);
-						}
-            
-						//set end values once
-						ofVec3f *vecEnd = (ofVec3f *)messages[i]->baseEndVals;
-						if(vecEnd){
-							if(vecEnd->x == OF_RELATIVE_VAL) x = material->getColorVec4f().x;
-							else x = vecEnd->x;
-							if(vecEnd->y == OF_RELATIVE_VAL) y = material->getColorVec4f().y;
-							else y = vecEnd->y;
-							if(vecEnd->z == OF_RELATIVE_VAL) z = material->getColorVec4f().z;
-							else z = vecEnd->z;
-              
-							messages[i]->setEndVals(x,y,z);
-						}
-            
-						//printf("color startvals = %f, %f , %f\n", x,y,z);
-						messages[i]->isRunning = true;
-					}
-					//update value
-					if(messages[i]->path == OF_LINEAR_PATH){
-						setColor((1-t)*((ofVec3f *)messages[i]->startVals)->x + t*((ofVec3f *)messages[i]->endVals)->x,
-                     (1-t)*((ofVec3f *)messages[i]->startVals)->y + t*((ofVec3f *)messages[i]->endVals)->y,
-                     (1-t)*((ofVec3f *)messages[i]->startVals)->z + t*((ofVec3f *)messages[i]->endVals)->z);
-					}else if(messages[i]->path == OF_BEZIER_PATH){
-						ofVec4f c = ofxMessage::bezier(t, messages[i]->pathPoints);
-						setColor(c.x, c.y, c.z);
-					}else if(messages[i]->path == OF_SPLINE_PATH){
-						ofVec4f c = ofxMessage::spline(t, messages[i]->pathPoints);
-						setColor(c.x, c.y, c.z);
-					}
-				}
-			}      // color with alpha channel
-      else if(messages[i]->id == OF_SETCOLOR4){
-				if(curTime >= startTime){
-					if(!messages[i]->isRunning){
-						//set start values once
-						ofVec4f *vec = (ofVec4f *)messages[i]->baseStartVals;
-						if(vec){
-							if(vec->x == OF_RELATIVE_VAL) x = material->getColorVec4f().x;
-							else x = vec->x;
-							if(vec->y == OF_RELATIVE_VAL) y = material->getColorVec4f().y;
-							else y = vec->y;
-							if(vec->z == OF_RELATIVE_VAL) z = material->getColorVec4f().z;
-							else z = vec->z;
-              if(vec->w == OF_RELATIVE_VAL) w = material->getColorVec4f().w;
-							else w = vec->w;
-              
-							messages[i]->setStartVals(x, y, z, w);
-						}
-            
-						//set end values once
-						ofVec4f *vecEnd = (ofVec4f *)messages[i]->baseEndVals;
-						if(vecEnd){
-							if(vecEnd->x == OF_RELATIVE_VAL) x = material->getColorVec4f().x;
-							else x = vecEnd->x;
-							if(vecEnd->y == OF_RELATIVE_VAL) y = material->getColorVec4f().y;
-							else y = vecEnd->y;
-							if(vecEnd->z == OF_RELATIVE_VAL) z = material->getColorVec4f().z;
-							else z = vecEnd->z;
-              if(vecEnd->w == OF_RELATIVE_VAL) w = material->getColorVec4f().w;
-							else w = vecEnd->w;
-              
-							messages[i]->setEndVals(x,y,z,w);
-						}
-            
-						//printf("color startvals = %f, %f , %f\n", x,y,z);
-						messages[i]->isRunning = true;
-					}
-					//update value
-					if(messages[i]->path == OF_LINEAR_PATH){
-						setColor((1-t)*((ofVec4f *)messages[i]->startVals)->x + t*((ofVec4f *)messages[i]->endVals)->x,
-                     (1-t)*((ofVec4f *)messages[i]->startVals)->y + t*((ofVec4f *)messages[i]->endVals)->y,
-                     (1-t)*((ofVec4f *)messages[i]->startVals)->z + t*((ofVec4f *)messages[i]->endVals)->z,
-                     (1-t)*((ofVec4f *)messages[i]->startVals)->w + t*((ofVec4f *)messages[i]->endVals)->w);
-					}else if(messages[i]->path == OF_BEZIER_PATH){
-						ofVec4f c = ofxMessage::bezier(t, messages[i]->pathPoints);
-						setColor(c.x, c.y, c.z, c.w);
-					}else if(messages[i]->path == OF_SPLINE_PATH){
-						ofVec4f c = ofxMessage::spline(t, messages[i]->pathPoints);
-						setColor(c.x, c.y, c.z, c.w);
-					}
-				}
-			}
-			//alpha__________________________________________________________________
-			else if(messages[i]->id == OF_SETALPHA){
-				if(curTime >= startTime){
-					if(!messages[i]->isRunning){
-						//set start values once
-						float *v = (float *)messages[i]->baseStartVals;
-						if(v){
-							if(v[0] == OF_RELATIVE_VAL) x = material->getColorVec4f().w;
-							else x = v[0];
-              
-							messages[i]->setStartVals(x);
-						}
-            
-						//set end values once
-						float *vEnd = (float *)messages[i]->baseEndVals;
-						if(vEnd){
-							if(vEnd[0] == OF_RELATIVE_VAL) x = material->getColorVec4f().w;
-							else x = vEnd[0];
-              
-							messages[i]->setEndVals(x);
-						}
-            
-						messages[i]->isRunning = true;
-					}
-					//update value
-					if(messages[i]->path == OF_LINEAR_PATH){
-						setAlpha((1-t)*((float *)messages[i]->startVals)[0] + t*((float *)messages[i]->endVals)[0]);
-					}else if(messages[i]->path == OF_BEZIER_PATH){
-						ofVec4f s = ofxMessage::bezier(t, messages[i]->pathPoints);
-						setAlpha(s.x);
-					}else if(messages[i]->path == OF_SPLINE_PATH){
-						ofVec4f s = ofxMessage::spline(t, messages[i]->pathPoints);
-						setAlpha(s.x);
-					}
-				}
-			}
-			//show____________________________________________________________________
-			else if(messages[i]->id == OF_SHOW){
-				if(curTime >= startTime){
-					show();
-					messages[i]->isEnabled = false;
-				}
-			}
-			//hide____________________________________________________________________
-			else if(messages[i]->id == OF_HIDE){
-				if(curTime >= startTime){
-          hide();
-					messages[i]->isEnabled = false;
-				}
-			}
-      
-			//function________________________________________________________________
-			else if(messages[i]->id == OF_FUNCTION){
-				if(curTime >= startTime){
-          messages[i]->functionPtr(messages[i]->startVals);
-					messages[i]->isEnabled = false;
-				}
-			}
-      
-      
-			//cleanup messages _____________________________________________________________________________________
-			//if the message is done and no longer needed, delete it
-			if(time == 1.0){ //only delete it when it's reached completion
-				messages[i]->isEnabled = false;
-				messages[i]->isRunning = false;
-        
-				if(messages[i]->autoDelete){
-					deleteMessage(messages[i]);
-				}
-        
-				if(i < messages.size()){	//just in case a message just got deleted above
-					//handle special looping behaviors
-					if(messages[i]->playMode == OF_LOOP_PLAY){
-						messages[i]->isEnabled = true;
-						messages[i]->isRunning = false;
-						messages[i]->setStartTime(curTime);
-					}
-					else if(messages[i]->playMode == OF_LOOP_PALINDROME_PLAY){
-						messages[i]->loopDirection = !messages[i]->loopDirection;
-						messages[i]->isEnabled = true;
-						messages[i]->isRunning = false;
-						messages[i]->setStartTime(curTime);
-					}
-				}
-			}
-		}
+		if((messages[i]->timeline == NULL) && messages[i]->isEnabled)
+			curTimeline->add(this, messages[i]);
 	}
+	hasUnscheduledMessages = false;
+}
+
+void ofxObject::scheduleMessage(ofxMessage *iMessage)
+{
+	if(iMessage->timeline)
+		iMessage->timeline->add(this, iMessage);	//restarts it
+	else if(curTimeline)
+		curTimeline->add(this, iMessage);
+	else
+		hasUnscheduledMessages = true;
 }
 
 bool ofxObject::isAnimating()
@@ -1280,99 +1000,128 @@ bool ofxObject::isAnimating()
 
 void ofxObject::deleteMessage(ofxMessage *iMessage)
 {
-	for(unsigned int i=0; i < messages.size(); i++){
-		if(iMessage == messages[i]){
-			delete iMessage;
-			messages.erase(messages.begin() + i);
-			//printf("ofxObject::deleteMessage()\n");
-      
-			return;
-		}
-	}
+	if(iMessage->owner == this)
+		delete iMessage;	//takes itself off the list
 }
 
 //Remove it, but don't delete it.
 bool ofxObject::removeMessage(ofxMessage *iMessage)
 {
-	//printf("ofxObject::removeMessage()\n");
-	for(unsigned int i=0; i < messages.size(); i++){
-		if(iMessage == messages[i]){
-			messages.erase(messages.begin() + i);
-			//printf("succeeded\n");
-			return true;
-		}
-	}
-	return false;
+	if(iMessage->owner != this) return false;
+
+	if(iMessage->timeline) iMessage->timeline->remove(iMessage);
+	detachMessage(iMessage);
+	return true;
 }
 
+//Stops and deletes the message, if it still exists and is this object's.
+void ofxObject::stopMessage(ofxMessageHandle iHandle)
+{
+	ofxMessage *message = iHandle.get();
+	if(message) deleteMessage(message);
+}
 
+//Deletes all messages of iMessageType, or all messages with the default of -1.
 void ofxObject::stopMessages(int iMessageType)
 {
-	bool deleteFlag = true;
-  //DEV: refactor this loop not to iterate backwards?
-	for(unsigned int i=0; i < messages.size(); i++){
-		if(iMessageType > -1){
-			if(messages[i]->id != iMessageType)
-				deleteFlag = false;
-		}
-		if(deleteFlag){
-			delete(messages[i]);
-			messages.erase(messages.begin() + i);
-			i--;
-		}
+	if(iMessageType < 0){
+		while(!messages.empty())
+			delete messages.back();
+		return;
 	}
+	if(iMessageType >= OF_NUM_MESSAGE_TYPES) return;
+
+	while(messageSlots[iMessageType])
+		delete messageSlots[iMessageType];
+}
+
+//Messages are kept in slots by id, and each knows its place in messages, so adding, finding and
+//removing them doesn't search. Removing swaps the last message into the gap.
+void ofxObject::attachMessage(ofxMessage *iMessage)
+{
+	iMessage->owner = this;
+	iMessage->ownerIndex = (int)messages.size();
+	messages.push_back(iMessage);
+
+	iMessage->prevOfType = NULL;
+	iMessage->nextOfType = NULL;
+	if((iMessage->id < 0) || (iMessage->id >= OF_NUM_MESSAGE_TYPES)) return;
+
+	ofxMessage *&slot = messageSlots[iMessage->id];
+	iMessage->nextOfType = slot;
+	if(slot) slot->prevOfType = iMessage;
+	slot = iMessage;
+}
+
+void ofxObject::detachMessage(ofxMessage *iMessage)
+{
+	if(iMessage->owner != this) return;
+
+	int i = iMessage->ownerIndex;
+	ofxMessage *last = messages.back();
+	messages[i] = last;
+	last->ownerIndex = i;
+	messages.pop_back();
+
+	if(iMessage->prevOfType)
+		iMessage->prevOfType->nextOfType = iMessage->nextOfType;
+	else if((iMessage->id >= 0) && (iMessage->id < OF_NUM_MESSAGE_TYPES))
+		messageSlots[iMessage->id] = iMessage->nextOfType;
+	if(iMessage->nextOfType)
+		iMessage->nextOfType->prevOfType = iMessage->prevOfType;
+
+	iMessage->owner = NULL;
+	iMessage->ownerIndex = -1;
+	iMessage->prevOfType = NULL;
+	iMessage->nextOfType = NULL;
 }
 
 
 ofxMessage* ofxObject::doMessage0f(int iID, float iDelay, float iDuration, int iInterp)
 {
-	ofxMessage *message =new ofxMessage(iID, NULL, iInterp, iDuration, iDelay);
-	messages.push_back(message);
+	ofxMessage *message = new ofxMessage(iID, ofVec4f(0, 0, 0, 0), iInterp, iDuration, iDelay);
+	attachMessage(message);
+	scheduleMessage(message);
   
 	return message;
 }
 
 ofxMessage* ofxObject::doMessage1f(int iID, float iDelay, float iDuration, int iInterp, float iVal)
 {
-	float *args = new float[1];
-	args[0] = iVal;
-  
-	ofxMessage *message = new ofxMessage(iID, (void *)args, iInterp, iDuration, iDelay);
+	ofxMessage *message = new ofxMessage(iID, ofVec4f(iVal, 0, 0, 0), iInterp, iDuration, iDelay);
   message->setStartTime(curTime);
-	messages.push_back(message);
+	attachMessage(message);
+	scheduleMessage(message);
   
 	return message;
 }
 
 ofxMessage* ofxObject::doMessage3f(int iID, float iDelay, float iDuration, int iInterp, float iVal0, float iVal1, float iVal2)
 {
-	ofVec3f *args = new ofVec3f();
-	args->set(iVal0, iVal1, iVal2);
-  
-	ofxMessage *message = new ofxMessage(iID, (void *)args, iInterp, iDuration, iDelay);
+	ofxMessage *message = new ofxMessage(iID, ofVec4f(iVal0, iVal1, iVal2, 0), iInterp, iDuration, iDelay);
   message->setStartTime(curTime);
-	messages.push_back(message);
+	attachMessage(message);
+	scheduleMessage(message);
   
 	return message;
 }
 
 ofxMessage* ofxObject::doMessage4f(int iID, float iDelay, float iDuration, int iInterp, float iVal0, float iVal1, float iVal2, float iVal3)
 {
-	ofVec4f *args = new ofVec4f();
-	args->set(iVal0, iVal1, iVal2, iVal3);
-  
-	ofxMessage *message =new ofxMessage(iID, (void *)args, iInterp, iDuration, iDelay);
+	ofxMessage *message = new ofxMessage(iID, ofVec4f(iVal0, iVal1, iVal2, iVal3), iInterp, iDuration, iDelay);
   message->setStartTime(curTime);
-	messages.push_back(message);
+	attachMessage(message);
+	scheduleMessage(message);
   
 	return message;
 }
 
-ofxMessage* ofxObject::doMessageNf(int iID, float iDelay, float iDuration, int iInterp, int iPath, vector<ofVec4f> iPathPoints)
+ofxMessage* ofxObject::doMessageNf(int iID, float iDelay, float iDuration, int iInterp, int iPath, const vector<ofVec4f> &iPathPoints)
 {
 	ofxMessage *message = new ofxMessage(iID, iInterp, iPath, iPathPoints, iDuration, iDelay);
   message->setStartTime(curTime);
-	messages.push_back(message);
+	attachMessage(message);
+	scheduleMessage(message);
   
 	return message;
 }
@@ -1388,8 +1137,11 @@ ofxMessage* ofxObject::doMessage(ofxMessage *iMessage)
     iMessage->setStartTime(curTime);
   }
 	iMessage->enableMessage(true);
-	if(!hasMessage(iMessage))	//only add it if it's not already there
-		messages.push_back(iMessage);
+	if(iMessage->owner != this){	//only add it if it's not already there
+		if(iMessage->owner) iMessage->owner->removeMessage(iMessage);
+		attachMessage(iMessage);
+	}
+	scheduleMessage(iMessage);
 	
 	return iMessage;
 }
@@ -1397,11 +1149,20 @@ ofxMessage* ofxObject::doMessage(ofxMessage *iMessage)
 //Lets you know if this message already in messages
 bool ofxObject::hasMessage(ofxMessage *iMessage)
 {
-	for(unsigned int i=0; i < messages.size(); i++){
-		if(messages[i] == iMessage)
-			return true;
-	}
-	return false;
+	return iMessage->owner == this;
+}
+
+bool ofxObject::hasMessageType(int iMessageType)
+{
+	return getFirstMessage(iMessageType) != NULL;
+}
+
+//The most recently added message of iMessageType. Follow nextOfType for the others.
+ofxMessage* ofxObject::getFirstMessage(int iMessageType)
+{
+	if((iMessageType < 0) || (iMessageType >= OF_NUM_MESSAGE_TYPES)) return NULL;
+
+	return messageSlots[iMessageType];
 }
 
 int ofxObject::isDescendant(ofxObject *iObject)
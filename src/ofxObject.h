@@ -33,6 +33,7 @@
 #include "ofGraphics.h"
 #include "ofMath.h"
 #include "ofxMessage.h"
+#include "ofxMessageTimeline.h"
 #include "ofShader.h"
 //#include "ofxVectorMath.h" //OF7
 
@@ -76,6 +77,8 @@ public :
 	virtual void			postdraw();
 	void							draw(ofxObjectMaterial *iMaterial, float *iMatrix, int iSelect=OF_RENDER_ALL, bool iDrawAlone=false);		//v4.0 added material arg
 	virtual void			render();
+  virtual bool      isBatchable(){ return false; }     //true if render() only queues geometry for flushBatch()
+  static void       flushBatch();
 	
   void							idleBase(float iTime);
 	virtual void			idle(float iTime){};
@@ -142,6 +145,7 @@ public :
  	void							enableAlphaInheritance(bool iEnable);
 	int								collectNodes(int iSelect, ofxObject *iNodes[], int iNumber, int iMax);
 	ofVec3f						getWindowCoords();
+  float             getPixelsPerUnit();
 
   void							setLighting(bool iOnOff);
   
@@ -160,19 +164,33 @@ public :
 	void							updateMessages();
 	void							deleteMessage(ofxMessage *iMessage);
 	bool							hasMessage(ofxMessage *iMessage);
+	bool							hasMessageType(int iMessageType);
+	ofxMessage*				getFirstMessage(int iMessageType);
 	bool							removeMessage(ofxMessage *iMessage);
+	void							stopMessage(ofxMessageHandle iHandle);
   
 	ofxMessage*				doMessage(ofxMessage *iMessage);
 	ofxMessage*				doMessage0f(int iID, float iDelay, float iDuration=0, int iInterp=OF_LINEAR);
 	ofxMessage*				doMessage1f(int iID, float iDelay, float iDuration, int iInterp, float iVal);
 	ofxMessage*				doMessage3f(int iID, float iDelay, float iDuration, int iInterp, float iVal0, float iVal1, float iVal2);
 	ofxMessage*				doMessage4f(int iID, float iDelay, float iDuration, int iInterp, float iVal0, float iVal1, float iVal2, float iVal3);
-	ofxMessage*				doMessageNf(int iID, float iDelay, float iDuration, int iInterp, int iPath, vector<ofVec4f> iPathPoints);
+	ofxMessage*				doMessageNf(int iID, float iDelay, float iDuration, int iInterp, int iPath, const vector<ofVec4f> &iPathPoints);
 	void							stopMessages(int iMessageType=-1);
   
+protected:
+	friend class ofxMessage;
+	friend class ofxMessageTimeline;
+	friend class ofxGroupTween;
+	void							attachMessage(ofxMessage *iMessage);
+	void							detachMessage(ofxMessage *iMessage);
+
+public:
+  
 	static void				Mul(float *source1, float *source2, float *dest);
 	static void				LoadIdentity(float *dest);
 	static void				Transpose(float *source, float *dest);
+  static void       setProjection(float *iProjectionMatrix, float iViewportHeight);
+  static int        getCurveResolution(float iPixelRadius, float iTolerance, int iMinRes, int iMaxRes);
   
 protected:
 	bool							shown;
@@ -190,6 +208,10 @@ protected:
 	bool							isLit;
 	static bool				prevLit;
   
+  static void       (*batchFlushFunc)();    //set by batching objects when they have geometry queued
+  void              queueBatch(void (*iFlushFunc)());
+  void              scheduleMessage(ofxMessage *iMessage);
+  
 	ofVec3f						xyzRot,
                     xyz,
                     scale;
@@ -212,6 +234,10 @@ protected:
 	vector <ofxObject *>			parents;
   vector <ofxObject *>      children_to_remove;
 	vector<ofxMessage *>			messages;
+	ofxMessage						*messageSlots[OF_NUM_MESSAGE_TYPES];	//first message of each id, linked through nextOfType
+  bool              hasUnscheduledMessages;   //messages added while no timeline was active
+  vector<ofxGroupTween *>   groupTweens;    //group tweens this object is a member of
+  int               numEvents;                //queued or last dispatched timeline events naming this object
 	
   //ofxObjectMaterial				*material,
   //							*drawMaterial;
@@ -222,6 +248,9 @@ public:
 	static bool				alwaysMatrixDirty;
   bool              inheritColor;
 	static float			curTime;
+  static ofxMessageTimeline *curTimeline;   //timeline of the scene being updated
+  static float      curProjection[16];
+  static float      curViewportHeight;
   
 	ofxObjectMaterial				*material,
                           *drawMaterial;
@@ -1,4 +1,5 @@
 #include "ofxPolygonObject.h"
+#include <cfloat>
 
 ofxPolygonObject::ofxPolygonObject(int iNumVertices)
 {
@@ -7,13 +8,24 @@ ofxPolygonObject::ofxPolygonObject(int iNumVertices)
 	vertices = new float[3*iNumVertices];
 	texCoords = new float[2*iNumVertices];
 	vertexColors = new float[4*iNumVertices];
-	//init all vertex colors to white
+	//init all vertices to the origin and all vertex colors to white
+	for(int i=0; i < (3*numVertices); i++){
+		vertices[i] = 0;
+	}
+	for(int i=0; i < (2*numVertices); i++){
+		texCoords[i] = 0;
+	}
 	for(int i=0; i < (4*numVertices); i++){
 		vertexColors[i] = 1.0;
 	}
 	vertexColoringEnabled = false;
 	texture = NULL;
   
+  vertexBuffer.setNumVertices(numVertices);
+  ibo = 0;
+  
+  isTessellationEnabled = false;
+  isTessellationDirty = true;
 }
 
 ofxPolygonObject::~ofxPolygonObject()
@@ -21,27 +33,63 @@ ofxPolygonObject::~ofxPolygonObject()
 	delete[] vertices;
   delete[] texCoords;
   delete[] vertexColors;
+  
+  if(ibo) glDeleteBuffers(1, &ibo);
 }
 
 void ofxPolygonObject::render()
 {
+  if(numVertices < 1) return;
+  
+  vertexBuffer.upload(vertices, texCoords, vertexColors);
+  
+  if(isTessellationEnabled && isTessellationDirty && (drawMode == OF_FILLED)){
+    triangulate(vertices, numVertices, holeStarts, triangles);
+    if(!ibo) glGenBuffers(1, &ibo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, triangles.size()*sizeof(GLuint), triangles.size() ? &triangles[0] : NULL, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    isTessellationDirty = false;
+  }
+  
+  vertexBuffer.bind();
+  
 	if(texture){
 		glEnable(texture->getTextureData().textureTarget);
 		glBindTexture(texture->getTextureData().textureTarget, (GLuint)texture->getTextureData().textureID);
     
 		glEnableClientState( GL_TEXTURE_COORD_ARRAY );
-		glTexCoordPointer(2, GL_FLOAT, 0, texCoords);
+		glTexCoordPointer(2, GL_FLOAT, 0, vertexBuffer.getTexCoordsOffset());
 	}
   
 	if(vertexColoringEnabled){
 		glEnableClientState(GL_COLOR_ARRAY);
-		glColorPointer(4, GL_FLOAT, 0, vertexColors);
+		glColorPointer(4, GL_FLOAT, 0, vertexBuffer.getColorsOffset());
 	}
   
 	glEnableClientState(GL_VERTEX_ARRAY);
-	glVertexPointer(3, GL_FLOAT, 0, vertices);
-	if(numVertices < 4) glDrawArrays((drawMode == OF_FILLED) ? GL_TRIANGLES : GL_LINE_LOOP, 0, numVertices);	//GL_TRIANGLE_FAN don't work for < 4 verts
-	else glDrawArrays((drawMode == OF_FILLED) ? GL_TRIANGLE_FAN : GL_LINE_LOOP, 0, numVertices);
+	glVertexPointer(3, GL_FLOAT, 0, 0);
+  
+  if(drawMode == OF_FILLED){
+    if(isTessellationEnabled){
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+      glDrawElements(GL_TRIANGLES, triangles.size(), GL_UNSIGNED_INT, 0);
+      glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+    else if(numVertices < 4) glDrawArrays(GL_TRIANGLES, 0, numVertices);	//GL_TRIANGLE_FAN don't work for < 4 verts
+    else glDrawArrays(GL_TRIANGLE_FAN, 0, numVertices);
+  }
+  else{
+    //one loop for the outline and one per hole
+    int first = 0;
+    for(int i=0; i <= (int)holeStarts.size(); i++){
+      int last = (i < (int)holeStarts.size()) ? holeStarts[i] : numVertices;
+      if(last > first) glDrawArrays(GL_LINE_LOOP, first, last - first);
+      first = last;
+    }
+  }
+  
+  glDisableClientState(GL_VERTEX_ARRAY);
   
 	if(texture){
 		glDisableClientState( GL_TEXTURE_COORD_ARRAY );
@@ -50,20 +98,49 @@ void ofxPolygonObject::render()
   
 	if(vertexColoringEnabled)
 		glDisableClientState(GL_COLOR_ARRAY);
+  
+  vertexBuffer.unbind();
+}
+
+//Any change to the outline invalidates the cached triangulation.
+void ofxPolygonObject::markPositionsDirty(int iFrom, int iTo)
+{
+  vertexBuffer.markPositionsDirty(iFrom, iTo);
+  isTessellationDirty = true;
 }
 
 void ofxPolygonObject::setVertexPos(int iVertexNum, ofVec3f iPos)
 {
-	if(iVertexNum < numVertices){
+	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
 		vertices[3*iVertexNum] = iPos.x;
 		vertices[3*iVertexNum + 1] = iPos.y;
 		vertices[3*iVertexNum + 2] = iPos.z;
+    markPositionsDirty(iVertexNum, iVertexNum);
 	}
 }
 
+void ofxPolygonObject::setVertices(const ofVec3f *iPositions, int iNumVerts, int iFirstVert)
+{
+  if(iFirstVert < 0) return;
+  iNumVerts = MIN(iNumVerts, numVertices - iFirstVert);
+  if(iNumVerts <= 0) return;
+  
+  for(int i=0; i < iNumVerts; i++){
+    vertices[3*(iFirstVert + i)] = iPositions[i].x;
+    vertices[3*(iFirstVert + i) + 1] = iPositions[i].y;
+    vertices[3*(iFirstVert + i) + 2] = iPositions[i].z;
+  }
+  markPositionsDirty(iFirstVert, iFirstVert + iNumVerts - 1);
+}
+
+void ofxPolygonObject::setVertices(const vector<ofVec3f> &iPositions)
+{
+  if(iPositions.size()) setVertices(&iPositions[0], iPositions.size());
+}
+
 void ofxPolygonObject::setVertexTexCoords(int iVertexNum, float iU, float iV)
 {
-	if(iVertexNum < numVertices){
+	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
 		//texCoords[2*iVertexNum] = iU;
 		//texCoords[2*iVertexNum + 1] = iV;
     
@@ -74,6 +151,7 @@ void ofxPolygonObject::setVertexTexCoords(int iVertexNum, float iU, float iV)
       
 			texCoords[2*iVertexNum + 1] = min(iV, texture->getHeight());
 			texCoords[2*iVertexNum + 1] = max(texCoords[2*iVertexNum + 1], 0.0f);
+      vertexBuffer.markTexCoordsDirty(iVertexNum, iVertexNum);
 		}
 		
 	}
@@ -97,15 +175,17 @@ ofVec2f ofxPolygonObject::getVertexTexCoords(int iVertexNum)
 	if(iVertexNum < numVertices){
 		return ofVec2f(texCoords[2*iVertexNum], texCoords[2*iVertexNum + 1]);
 	}
+  return ofVec2f();
 }
 
 void ofxPolygonObject::setVertexColor(int iVertexNum, float iR, float iG, float iB, float iA)
 {
-	if(iVertexNum < numVertices){
+	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
 		vertexColors[4*iVertexNum] = iR/255.0f;
 		vertexColors[4*iVertexNum + 1] = iG/255.0f;
 		vertexColors[4*iVertexNum + 2] = iB/255.0f;
 		vertexColors[4*iVertexNum + 3] = drawMaterial->color.a/255.0f * iA/255.0f;
+    vertexBuffer.markColorsDirty(iVertexNum, iVertexNum);
 		//automatically enable vertex coloring if this is called
 		vertexColoringEnabled = true;
 	}
@@ -134,4 +214,215 @@ void ofxPolygonObject::enableVertexColoring(bool iEnable)
 ofTexture* ofxPolygonObject::getTexture()
 {
 	return texture;
+}
+
+//Draw filled polygons from a cached triangulation instead of a fan, so concave outlines fill correctly.
+void ofxPolygonObject::enableTessellation(bool iEnable)
+{
+  if(iEnable && !isTessellationEnabled) isTessellationDirty = true;
+  isTessellationEnabled = iEnable;
+}
+
+//Each entry is the first vertex of a hole. Vertices before the first hole form the outline,
+//and each hole runs up to the next start (or the last vertex). Enables tessellation.
+void ofxPolygonObject::setHoles(const vector<int> &iHoleStarts)
+{
+  holeStarts.clear();
+  int prev = 0;
+  for(int i=0; i < (int)iHoleStarts.size(); i++){
+    if((iHoleStarts[i] > prev) && (iHoleStarts[i] < numVertices)){
+      holeStarts.push_back(iHoleStarts[i]);
+      prev = iHoleStarts[i];
+    }
+  }
+  
+  isTessellationDirty = true;
+  if(holeStarts.size()) isTessellationEnabled = true;
+}
+
+
+//Triangulation helpers. Points are projected to 2D before clipping.
+
+static float cross2(const ofVec2f &iA, const ofVec2f &iB, const ofVec2f &iC)
+{
+  return (iB.x - iA.x)*(iC.y - iA.y) - (iB.y - iA.y)*(iC.x - iA.x);
+}
+
+static float signedArea(const vector<ofVec2f> &iPts, const vector<int> &iRing)
+{
+  float area = 0;
+  for(int i=0, j=iRing.size()-1; i < (int)iRing.size(); j=i++)
+    area += (iPts[iRing[j]].x - iPts[iRing[i]].x)*(iPts[iRing[j]].y + iPts[iRing[i]].y);
+  return 0.5f*area;
+}
+
+static bool insideTriangle(const ofVec2f &iA, const ofVec2f &iB, const ofVec2f &iC, const ofVec2f &iP)
+{
+  return (cross2(iA, iB, iP) >= 0) && (cross2(iB, iC, iP) >= 0) && (cross2(iC, iA, iP) >= 0);
+}
+
+//Whether iP lies inside the corner at iB of a counter-clockwise ring running iA, iB, iC.
+static bool facesPoint(const ofVec2f &iA, const ofVec2f &iB, const ofVec2f &iC, const ofVec2f &iP)
+{
+  if(cross2(iA, iB, iC) >= 0) return (cross2(iA, iB, iP) >= 0) && (cross2(iB, iC, iP) >= 0);
+  return (cross2(iA, iB, iP) >= 0) || (cross2(iB, iC, iP) >= 0);
+}
+
+//Splices a clockwise hole into the counter-clockwise outline through a bridge edge to a visible outline vertex.
+static void bridgeHole(const vector<ofVec2f> &iPts, vector<int> &ioRing, const vector<int> &iHole)
+{
+  //rightmost hole vertex
+  int m = 0;
+  for(int i=1; i < (int)iHole.size(); i++)
+    if(iPts[iHole[i]].x > iPts[iHole[m]].x) m = i;
+  ofVec2f M = iPts[iHole[m]];
+  
+  //closest outline edge hit by a ray from M towards +x
+  int p = -1;
+  float hitX = FLT_MAX;
+  for(int i=0, j=ioRing.size()-1; i < (int)ioRing.size(); j=i++){
+    const ofVec2f &a = iPts[ioRing[j]], &b = iPts[ioRing[i]];
+    if((a.y == b.y) || ((a.y > M.y) == (b.y > M.y))) continue;
+    float x = a.x + (M.y - a.y)*(b.x - a.x)/(b.y - a.y);
+    if((x >= M.x) && (x < hitX)){
+      hitX = x;
+      p = (a.x > b.x) ? j : i;
+    }
+  }
+  if(p < 0) return;   //hole isn't inside the outline
+  
+  //an outline vertex inside the triangle (M, hit, P) would block the bridge, so take the one closest to the ray instead.
+  //Bridged vertices appear twice in the ring; only the copy whose corner faces M is usable.
+  ofVec2f I(hitX, M.y), P = iPts[ioRing[p]];
+  int best = -1;
+  float bestSlope = FLT_MAX, bestDist = FLT_MAX;
+  for(int i=0; i < (int)ioRing.size(); i++){
+    const ofVec2f &v = iPts[ioRing[i]];
+    if(!(v == P)){
+      if(v.x < M.x) continue;
+      bool inside = (P.y > M.y) ? insideTriangle(M, I, P, v) : insideTriangle(M, P, I, v);
+      if(!inside) continue;
+    }
+    if(!facesPoint(iPts[ioRing[(i + ioRing.size() - 1) % ioRing.size()]], v, iPts[ioRing[(i + 1) % ioRing.size()]], M)) continue;
+    
+    float dist = v.x - M.x;
+    float slope = (dist > 0) ? fabsf(v.y - M.y)/dist : FLT_MAX;
+    if((slope < bestSlope) || ((slope == bestSlope) && (dist < bestDist))){
+      bestSlope = slope;
+      bestDist = dist;
+      best = i;
+    }
+  }
+  if(best >= 0) p = best;
+  
+  //outline ... P, M, hole ..., M, P, outline ...
+  vector<int> bridged;
+  bridged.reserve(ioRing.size() + iHole.size() + 2);
+  bridged.insert(bridged.end(), ioRing.begin(), ioRing.begin() + p + 1);
+  for(int i=0; i <= (int)iHole.size(); i++)
+    bridged.push_back(iHole[(m + i) % iHole.size()]);
+  bridged.insert(bridged.end(), ioRing.begin() + p, ioRing.end());
+  ioRing.swap(bridged);
+}
+
+static bool sortByMaxX(const pair<float, int> &iA, const pair<float, int> &iB)
+{
+  return iA.first > iB.first;
+}
+
+//Ear clipping triangulation of an outline with optional holes (see setHoles()), writing triangle indices into oIndices.
+//Works on the plane the outline mostly faces.
+void ofxPolygonObject::triangulate(const float *iVertices, int iNumVertices, const vector<int> &iHoleStarts, vector<GLuint> &oIndices)
+{
+  oIndices.clear();
+  
+  int outlineEnd = iHoleStarts.size() ? iHoleStarts[0] : iNumVertices;
+  if(outlineEnd < 3) return;
+  
+  //Newell normal of the outline picks the axis to drop
+  float nx = 0, ny = 0, nz = 0;
+  for(int i=0, j=outlineEnd-1; i < outlineEnd; j=i++){
+    const float *a = &iVertices[3*j], *b = &iVertices[3*i];
+    nx += (a[1] - b[1])*(a[2] + b[2]);
+    ny += (a[2] - b[2])*(a[0] + b[0]);
+    nz += (a[0] - b[0])*(a[1] + b[1]);
+  }
+  int u = 0, v = 1;
+  if((fabsf(nx) > fabsf(ny)) && (fabsf(nx) > fabsf(nz))){ u = 1; v = 2; }
+  else if(fabsf(ny) > fabsf(nz)){ u = 2; v = 0; }
+  
+  vector<ofVec2f> pts(iNumVertices);
+  for(int i=0; i < iNumVertices; i++)
+    pts[i].set(iVertices[3*i + u], iVertices[3*i + v]);
+  
+  //counter-clockwise outline
+  vector<int> ring(outlineEnd);
+  for(int i=0; i < outlineEnd; i++) ring[i] = i;
+  if(signedArea(pts, ring) < 0) reverse(ring.begin(), ring.end());
+  
+  //clockwise holes, bridged in from right to left
+  vector<vector<int> > holes;
+  vector<pair<float, int> > order;
+  for(int h=0; h < (int)iHoleStarts.size(); h++){
+    int first = iHoleStarts[h];
+    int last = (h+1 < (int)iHoleStarts.size()) ? iHoleStarts[h+1] : iNumVertices;
+    if(last - first < 3) continue;
+    
+    vector<int> hole;
+    float maxX = -FLT_MAX;
+    for(int i=first; i < last; i++){
+      hole.push_back(i);
+      maxX = MAX(maxX, pts[i].x);
+    }
+    if(signedArea(pts, hole) > 0) reverse(hole.begin(), hole.end());
+    order.push_back(make_pair(maxX, (int)holes.size()));
+    holes.push_back(hole);
+  }
+  sort(order.begin(), order.end(), sortByMaxX);
+  for(int i=0; i < (int)order.size(); i++)
+    bridgeHole(pts, ring, holes[order[i].second]);
+  
+  //clip ears off a doubly linked ring
+  int count = ring.size();
+  vector<int> prev(count), next(count);
+  for(int i=0; i < count; i++){
+    prev[i] = (i + count - 1) % count;
+    next[i] = (i + 1) % count;
+  }
+  oIndices.reserve(3*(count - 2));
+  
+  int cur = 0, misses = 0;
+  while(count > 3){
+    int p = prev[cur], n = next[cur];
+    const ofVec2f &a = pts[ring[p]], &b = pts[ring[cur]], &c = pts[ring[n]];
+    
+    bool isEar = (cross2(a, b, c) > 0);
+    //only reflex vertices can sit inside an ear; bridge duplicates share a position with a corner and are skipped
+    for(int k=next[n]; isEar && (k != p); k=next[k]){
+      const ofVec2f &q = pts[ring[k]];
+      if((q == a) || (q == b) || (q == c)) continue;
+      if(cross2(pts[ring[prev[k]]], q, pts[ring[next[k]]]) > 0) continue;
+      if(insideTriangle(a, b, c, q)) isEar = false;
+    }
+    
+    //a full lap without an ear means the outline is degenerate or self-intersecting, so clip anyway
+    if(isEar || (misses > count)){
+      oIndices.push_back(ring[p]);
+      oIndices.push_back(ring[cur]);
+      oIndices.push_back(ring[n]);
+      next[p] = n;
+      prev[n] = p;
+      count--;
+      misses = 0;
+      cur = n;
+    }
+    else{
+      misses++;
+      cur = n;
+    }
+  }
+  
+  oIndices.push_back(ring[prev[cur]]);
+  oIndices.push_back(ring[cur]);
+  oIndices.push_back(ring[next[cur]]);
 }
\ No newline at end of file
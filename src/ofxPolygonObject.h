@@ -3,6 +3,9 @@
  
  ofxObject for creating and texturing arbitrary polygons. Also see ofxDynamicPolygonObject for
  an animatable version of ofxPolygon.
+ Vertex data lives in a vertex buffer, and only the vertices changed since the last frame are re-uploaded.
+ Polygons are drawn as convex fans by default. Call enableTessellation() for concave outlines, or setHoles()
+ to cut holes; the triangulation is cached and only recomputed when vertex positions change.
  
  Soso OpenFrameworks Addon
  Copyright (C) 2012 Sosolimited
@@ -26,6 +29,7 @@
 
 #include "ofxObject.h"
 #include "ofImage.h"
+#include "ofxVertexBuffer.h"
 
 class ofxPolygonObject : public ofxObject
 {
@@ -41,12 +45,25 @@ public:
 	virtual void          setVertexTexCoords(int iVertexNum, float iU, float iV);
 	virtual void          setVertexColor(int iVertexNum, float iR, float iG, float iB, float iA=255);
   
+  // bulk update, copying iNumVerts positions starting at vertex iFirstVert
+  void                  setVertices(const ofVec3f *iPositions, int iNumVerts, int iFirstVert=0);
+  void                  setVertices(const vector<ofVec3f> &iPositions);
+  
 	ofVec3f               getVertexPos(int iVertexNum);
 	ofVec2f               getVertexTexCoords(int iVertexNum);
 	void                  setDrawMode(int iDrawMode);	//OF_FILLED, OF_OUTLINE
 	void                  enableVertexColoring(bool iEnable);
 	ofTexture*            getTexture();
   
+  // concave outlines and holes
+  void                  enableTessellation(bool iEnable);
+  void                  setHoles(const vector<int> &iHoleStarts);
+  
+  static void           triangulate(const float *iVertices, int iNumVertices, const vector<int> &iHoleStarts, vector<GLuint> &oIndices);
+  
+protected:
+  void                  markPositionsDirty(int iFrom, int iTo);
+  
 protected:
 	bool                  vertexColoringEnabled;
 	int                   numVertices;
@@ -56,4 +73,12 @@ protected:
 	float                 *vertexColors;
 	ofTexture             *texture;
   
-};
+  ofxVertexBuffer       vertexBuffer;
+  GLuint                ibo;              //triangles from triangulate()
+  
+  bool                  isTessellationEnabled,
+                        isTessellationDirty;
+  vector<int>           holeStarts;
+  vector<GLuint>        triangles;
+  
+};
\ No newline at end of file
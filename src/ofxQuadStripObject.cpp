@@ -7,13 +7,20 @@ ofxQuadStripObject::ofxQuadStripObject(int iNumVertices)
 	vertices = new float[3*iNumVertices];
 	texCoords = new float[2*iNumVertices];
 	vertexColors = new float[4*iNumVertices];
-	//init all vertex colors to white
+	//init all vertices to the origin and all vertex colors to white
+	for(int i=0; i < (3*numVertices); i++){
+		vertices[i] = 0;
+	}
+	for(int i=0; i < (2*numVertices); i++){
+		texCoords[i] = 0;
+	}
 	for(int i=0; i < (4*numVertices); i++){
 		vertexColors[i] = 1.0;
 	}
 	vertexColoringEnabled = false;
 	texture = NULL;
   
+  vertexBuffer.setNumVertices(numVertices);
 }
 
 ofxQuadStripObject::~ofxQuadStripObject()
@@ -25,22 +32,29 @@ ofxQuadStripObject::~ofxQuadStripObject()
 
 void ofxQuadStripObject::render()
 {
+  if(numVertices < 1) return;
+  
+  vertexBuffer.upload(vertices, texCoords, vertexColors);
+  vertexBuffer.bind();
+  
 	if(texture){
 		glEnable(texture->getTextureData().textureTarget);
 		glBindTexture(texture->getTextureData().textureTarget, (GLuint)texture->getTextureData().textureID);
     
 		glEnableClientState( GL_TEXTURE_COORD_ARRAY );
-		glTexCoordPointer(2, GL_FLOAT, 0, texCoords);
+		glTexCoordPointer(2, GL_FLOAT, 0, vertexBuffer.getTexCoordsOffset());
 	}
   
 	if(vertexColoringEnabled){
 		glEnableClientState(GL_COLOR_ARRAY);
-		glColorPointer(4, GL_FLOAT, 0, vertexColors);
+		glColorPointer(4, GL_FLOAT, 0, vertexBuffer.getColorsOffset());
 	}
   
 	glEnableClientState(GL_VERTEX_ARRAY);
-	glVertexPointer(3, GL_FLOAT, 0, vertices);
-	glDrawArrays((drawMode == OF_FILLED) ? GL_QUAD_STRIP : GL_LINE_LOOP, 0, numVertices);
+	glVertexPointer(3, GL_FLOAT, 0, 0);
+	//quad strip vertex order is already triangle strip order, and draws the same quads
+	glDrawArrays((drawMode == OF_FILLED) ? GL_TRIANGLE_STRIP : GL_LINE_LOOP, 0, numVertices);
+	glDisableClientState(GL_VERTEX_ARRAY);
   
 	if(texture){
 		glDisableClientState( GL_TEXTURE_COORD_ARRAY );
@@ -49,20 +63,42 @@ void ofxQuadStripObject::render()
   
 	if(vertexColoringEnabled)
 		glDisableClientState(GL_COLOR_ARRAY);
+  
+  vertexBuffer.unbind();
 }
 
 void ofxQuadStripObject::setVertexPos(int iVertexNum, ofVec3f iPos)
 {
-	if(iVertexNum < numVertices){
+	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
 		vertices[3*iVertexNum] = iPos.x;
 		vertices[3*iVertexNum + 1] = iPos.y;
 		vertices[3*iVertexNum + 2] = iPos.z;
+    vertexBuffer.markPositionsDirty(iVertexNum, iVertexNum);
 	}
 }
 
+void ofxQuadStripObject::setVertices(const ofVec3f *iPositions, int iNumVerts, int iFirstVert)
+{
+  if(iFirstVert < 0) return;
+  iNumVerts = MIN(iNumVerts, numVertices - iFirstVert);
+  if(iNumVerts <= 0) return;
+  
+  for(int i=0; i < iNumVerts; i++){
+    vertices[3*(iFirstVert + i)] = iPositions[i].x;
+    vertices[3*(iFirstVert + i) + 1] = iPositions[i].y;
+    vertices[3*(iFirstVert + i) + 2] = iPositions[i].z;
+  }
+  vertexBuffer.markPositionsDirty(iFirstVert, iFirstVert + iNumVerts - 1);
+}
+
+void ofxQuadStripObject::setVertices(const vector<ofVec3f> &iPositions)
+{
+  if(iPositions.size()) setVertices(&iPositions[0], iPositions.size());
+}
+
 void ofxQuadStripObject::setVertexTexCoords(int iVertexNum, float iU, float iV)
 {
-	if(iVertexNum < numVertices){
+	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
 		//texCoords[2*iVertexNum] = iU;
 		//texCoords[2*iVertexNum + 1] = iV;
     
@@ -73,11 +109,33 @@ void ofxQuadStripObject::setVertexTexCoords(int iVertexNum, float iU, float iV)
       
 			texCoords[2*iVertexNum + 1] = min(iV, texture->getHeight());
 			texCoords[2*iVertexNum + 1] = max(texCoords[2*iVertexNum + 1], 0.0f);
+      vertexBuffer.markTexCoordsDirty(iVertexNum, iVertexNum);
 		}
 		
 	}
 }
 
+//Like the single vertex version, tex coords are clamped to the texture and ignored until one is set.
+void ofxQuadStripObject::setVertexTexCoords(const ofVec2f *iTexCoords, int iNumVerts, int iFirstVert)
+{
+  if(!texture || (iFirstVert < 0)) return;
+  iNumVerts = MIN(iNumVerts, numVertices - iFirstVert);
+  if(iNumVerts <= 0) return;
+  
+  float w = texture->getWidth();
+  float h = texture->getHeight();
+  for(int i=0; i < iNumVerts; i++){
+    texCoords[2*(iFirstVert + i)] = MIN(MAX(iTexCoords[i].x, 0.0f), w);
+    texCoords[2*(iFirstVert + i) + 1] = MIN(MAX(iTexCoords[i].y, 0.0f), h);
+  }
+  vertexBuffer.markTexCoordsDirty(iFirstVert, iFirstVert + iNumVerts - 1);
+}
+
+void ofxQuadStripObject::setVertexTexCoords(const vector<ofVec2f> &iTexCoords)
+{
+  if(iTexCoords.size()) setVertexTexCoords(&iTexCoords[0], iTexCoords.size());
+}
+
 ofVec3f ofxQuadStripObject::getVertexPos(int iVertexNum)
 {
 	ofVec3f result;
@@ -96,15 +154,17 @@ ofVec2f ofxQuadStripObject::getVertexTexCoords(int iVertexNum)
 	if(iVertexNum < numVertices){
 		return ofVec2f(texCoords[2*iVertexNum], texCoords[2*iVertexNum + 1]);
 	}
+  return ofVec2f();
 }
 
 void ofxQuadStripObject::setVertexColor(int iVertexNum, float iR, float iG, float iB, float iA)
 {
-	if(iVertexNum < numVertices){
+	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
 		vertexColors[4*iVertexNum] = iR/255.0f;
 		vertexColors[4*iVertexNum + 1] = iG/255.0f;
 		vertexColors[4*iVertexNum + 2] = iB/255.0f;
 		vertexColors[4*iVertexNum + 3] = drawMaterial->color.a/255.0f * iA/255.0f;
+    vertexBuffer.markColorsDirty(iVertexNum, iVertexNum);
 		//automatically enable vertex coloring if this is called
 		vertexColoringEnabled = true;
 	}
@@ -112,10 +172,11 @@ void ofxQuadStripObject::setVertexColor(int iVertexNum, float iR, float iG, floa
 
 void ofxQuadStripObject::setVertexColorOnly(int iVertexNum, float iR, float iG, float iB)
 {
-	if(iVertexNum < numVertices){
+	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
 		vertexColors[4*iVertexNum] = iR/255.0f;
 		vertexColors[4*iVertexNum + 1] = iG/255.0f;
 		vertexColors[4*iVertexNum + 2] = iB/255.0f;
+    vertexBuffer.markColorsDirty(iVertexNum, iVertexNum);
     
 		//automatically enable vertex coloring if this is called
 		vertexColoringEnabled = true;
@@ -123,13 +184,38 @@ void ofxQuadStripObject::setVertexColorOnly(int iVertexNum, float iR, float iG,
 }
 void ofxQuadStripObject::setVertexAlpha(int iVertexNum, float iA)
 {
-	if(iVertexNum < numVertices){
+	if((iVertexNum >= 0) && (iVertexNum < numVertices)){
 		vertexColors[4*iVertexNum + 3] = drawMaterial->color.a/255.0f * iA/255.0f;
+    vertexBuffer.markColorsDirty(iVertexNum, iVertexNum);
 		//automatically enable vertex coloring if this is called
 		vertexColoringEnabled = true;
 	}
 }
 
+//Vertex alpha is multiplied by the object's alpha at the time of the call, as with setVertexColor().
+void ofxQuadStripObject::setVertexColors(const ofColor *iColors, int iNumVerts, int iFirstVert)
+{
+  if(iFirstVert < 0) return;
+  iNumVerts = MIN(iNumVerts, numVertices - iFirstVert);
+  if(iNumVerts <= 0) return;
+  
+  float alpha = drawMaterial->color.a/255.0f;
+  float *dst = &vertexColors[4*iFirstVert];
+  for(int i=0; i < iNumVerts; i++){
+    dst[4*i] = iColors[i].r/255.0f;
+    dst[4*i + 1] = iColors[i].g/255.0f;
+    dst[4*i + 2] = iColors[i].b/255.0f;
+    dst[4*i + 3] = alpha * iColors[i].a/255.0f;
+  }
+  vertexBuffer.markColorsDirty(iFirstVert, iFirstVert + iNumVerts - 1);
+  vertexColoringEnabled = true;
+}
+
+void ofxQuadStripObject::setVertexColors(const vector<ofColor> &iColors)
+{
+  if(iColors.size()) setVertexColors(&iColors[0], iColors.size());
+}
+
 //OF_FILLED, OF_OUTLINE
 void ofxQuadStripObject::setDrawMode(int iDrawMode)
 {
@@ -141,6 +227,11 @@ void ofxQuadStripObject::setTexture(ofImage *iTex)
 	texture = &iTex->getTexture();
 }
 
+int ofxQuadStripObject::getNumVertices()
+{
+  return numVertices;
+}
+
 void ofxQuadStripObject::enableVertexColoring(bool iEnable)
 {
 	vertexColoringEnabled = iEnable;
@@ -3,6 +3,9 @@
  
  ofxObject for creating and texturing Quadstrips. Also see ofxDynamicPolygonObject for
  an animatable version of ofxPolygon.
+ Vertices are ordered as for GL_QUAD_STRIP and drawn as a triangle strip from a vertex buffer.
+ Only the vertices changed since the last frame are re-uploaded, so use the bulk setters to
+ update long ribbons in one copy.
  
  Soso OpenFrameworks Addon
  Copyright (C) 2012 Sosolimited
@@ -26,6 +29,7 @@
 
 #include "ofxObject.h"
 #include "ofImage.h"
+#include "ofxVertexBuffer.h"
 
 
 class ofxQuadStripObject : public ofxObject
@@ -43,12 +47,21 @@ public:
   virtual void      setVertexColorOnly(int iVertexNum, float iR, float iG, float iB);
   virtual void      setVertexAlpha(int iVertexNum, float iA);
   
+  // bulk updates, copying iNumVerts entries starting at vertex iFirstVert
+  void              setVertices(const ofVec3f *iPositions, int iNumVerts, int iFirstVert=0);
+  void              setVertices(const vector<ofVec3f> &iPositions);
+  void              setVertexTexCoords(const ofVec2f *iTexCoords, int iNumVerts, int iFirstVert=0);
+  void              setVertexTexCoords(const vector<ofVec2f> &iTexCoords);
+  void              setVertexColors(const ofColor *iColors, int iNumVerts, int iFirstVert=0);
+  void              setVertexColors(const vector<ofColor> &iColors);
+  
 	ofVec3f           getVertexPos(int iVertexNum);
 	ofVec2f           getVertexTexCoords(int iVertexNum);
 	void              setDrawMode(int iDrawMode);	//OF_FILLED, OF_OUTLINE
 	void              enableVertexColoring(bool iEnable);
   ofVec4f           getVertexColor(int iVertexNum);
   float             getVertexAlpha(int iVertexNum);
+  int               getNumVertices();
   
 	ofTexture*				getTexture();
   
@@ -61,4 +74,6 @@ protected:
 	float             *vertexColors;
 	ofTexture         *texture;
   
-};
+  ofxVertexBuffer   vertexBuffer;
+  
+};
\ No newline at end of file
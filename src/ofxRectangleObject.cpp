@@ -8,6 +8,16 @@
  */
 
 #include "ofxRectangleObject.h"
+#include "ofxShapeRenderer.h"
+
+bool ofxRectangleObject::isBatchingEnabled = true;
+vector<float> ofxRectangleObject::batchVertices;
+vector<ofColor> ofxRectangleObject::batchColors;
+vector<GLuint> ofxRectangleObject::batchIndices;
+vector<ofxRectangleRun> ofxRectangleObject::batchRuns;
+ofxRectangleBatchState ofxRectangleObject::batchState;
+GLuint ofxRectangleObject::batchVbo = 0;
+GLuint ofxRectangleObject::batchIbo = 0;
 
 ofxRectangleObject::ofxRectangleObject(float iW, float iH)
 {
@@ -17,12 +27,64 @@ ofxRectangleObject::ofxRectangleObject(float iW, float iH)
   
 	strokeAlpha = 0.0;
 	fillAlpha = 255.0;
+  strokeWidth = 1.0;
+  isStrokeScaled = false;
+  cornerRadius = 0;
   
 }
 
 ofxRectangleObject::~ofxRectangleObject(){}
 
 void ofxRectangleObject::render()
+{
+  if(!isBatchable()){
+    renderImmediate();
+    return;
+  }
+  
+  ofColor color = getColor();
+  float x0 = isCentered ? -dimensions.x/2.0f : 0;
+  float y0 = isCentered ? -dimensions.y/2.0f : 0;
+  
+  //rounded corners come from the shape shader
+  if ((cornerRadius > 0) && ofxShapeRenderer::isSupported()) {
+    queueBatch(&ofxShapeRenderer::flush);
+    if (fillAlpha > 0.0) {
+      color.a = fillAlpha * drawMaterial->color.a/255.0;
+      ofxShapeRenderer::addRoundedRect(matrix, x0, y0, dimensions.x, dimensions.y, cornerRadius, color, color);
+    }
+    if (strokeAlpha > 0.0) {
+      color.a = strokeAlpha * drawMaterial->color.a/255.0;
+      ofxShapeRenderer::addRoundedRect(matrix, x0, y0, dimensions.x, dimensions.y, cornerRadius, color, color, strokeWidth);
+    }
+    return;
+  }
+  
+  //rectangles queued under a different blend func or line width go out first
+  ofxRectangleBatchState state;
+  getBatchState(state);
+  if (memcmp(&state, &batchState, sizeof(state)) != 0) flushBatch();
+  batchState = state;
+  queueBatch(&ofxRectangleObject::flushRectangles);
+  
+  if (fillAlpha > 0.0) {
+    color.a = fillAlpha * drawMaterial->color.a/255.0;
+    appendQuad(x0, y0, x0 + dimensions.x, y0 + dimensions.y, color);
+  }
+  if (strokeAlpha > 0.0) {
+    color.a = strokeAlpha * drawMaterial->color.a/255.0;
+    if (isStrokeScaled) appendFrame(x0, y0, x0 + dimensions.x, y0 + dimensions.y, strokeWidth, color);
+    else appendOutline(x0, y0, x0 + dimensions.x, y0 + dimensions.y, color);
+  }
+}
+
+//Shaders are bound per object, so shaded rectangles can't share the batch.
+bool ofxRectangleObject::isBatchable()
+{
+  return isBatchingEnabled && !(shaderEnabled && (shader != NULL));
+}
+
+void ofxRectangleObject::renderImmediate()
 {
 
 	ofColor color = getColor();
@@ -65,3 +127,126 @@ void ofxRectangleObject::setCentered(bool iB)
 	isCentered = iB;
 }
 
+//Turns batching on or off for all rectangles.
+void ofxRectangleObject::enableBatching(bool iEnable)
+{
+  if(!iEnable) flushBatch();
+  isBatchingEnabled = iEnable;
+}
+
+//Transforms iNumCorners corners by this object's matrix and appends them, returning the index of the first.
+GLuint ofxRectangleObject::appendCorners(const float *iCorners, int iNumCorners, const ofColor &iColor)
+{
+  GLuint first = batchColors.size();
+  
+  int v = batchVertices.size();
+  batchVertices.resize(v + 3*iNumCorners);
+  for(int i=0; i < iNumCorners; i++){
+    float x = iCorners[2*i], y = iCorners[2*i + 1];
+    batchVertices[v++] = matrix[0]*x + matrix[4]*y + matrix[12];
+    batchVertices[v++] = matrix[1]*x + matrix[5]*y + matrix[13];
+    batchVertices[v++] = matrix[2]*x + matrix[6]*y + matrix[14];
+  }
+  batchColors.resize(first + iNumCorners, iColor);
+  
+  return first;
+}
+
+//Appends iNumIndices indices, extending the last run if it draws the same primitive.
+void ofxRectangleObject::appendIndices(GLenum iMode, const GLuint *iIndices, int iNumIndices)
+{
+  if(batchRuns.empty() || (batchRuns.back().mode != iMode)){
+    ofxRectangleRun run = {iMode, (int)batchIndices.size(), 0};
+    batchRuns.push_back(run);
+  }
+  batchRuns.back().count += iNumIndices;
+  batchIndices.insert(batchIndices.end(), iIndices, iIndices + iNumIndices);
+}
+
+//Appends two triangles covering the rectangle.
+void ofxRectangleObject::appendQuad(float iX0, float iY0, float iX1, float iY1, const ofColor &iColor)
+{
+  float corners[8] = {iX0, iY0,  iX1, iY0,  iX1, iY1,  iX0, iY1};
+  GLuint first = appendCorners(corners, 4, iColor);
+  
+  GLuint indices[6] = {first, first+1, first+2,  first, first+2, first+3};
+  appendIndices(GL_TRIANGLES, indices, 6);
+}
+
+//Appends the outline as lines, drawn at the current line width like ofDrawRectangle() without fill.
+void ofxRectangleObject::appendOutline(float iX0, float iY0, float iX1, float iY1, const ofColor &iColor)
+{
+  float corners[8] = {iX0, iY0,  iX1, iY0,  iX1, iY1,  iX0, iY1};
+  GLuint first = appendCorners(corners, 4, iColor);
+  
+  GLuint indices[8] = {first, first+1,  first+1, first+2,  first+2, first+3,  first+3, first};
+  appendIndices(GL_LINES, indices, 8);
+}
+
+//Appends the outline as four quads of width iWidth, centered on the rectangle's edges.
+void ofxRectangleObject::appendFrame(float iX0, float iY0, float iX1, float iY1, float iWidth, const ofColor &iColor)
+{
+  float h = iWidth/2.0f;
+  appendQuad(iX0 - h, iY0 - h, iX1 + h, iY0 + h, iColor);   //bottom
+  appendQuad(iX0 - h, iY1 - h, iX1 + h, iY1 + h, iColor);   //top
+  appendQuad(iX0 - h, iY0 + h, iX0 + h, iY1 - h, iColor);   //left
+  appendQuad(iX1 - h, iY0 + h, iX1 + h, iY1 - h, iColor);   //right
+}
+
+//Reads the blend func, blend equation and line width that rectangles drawn now would use.
+void ofxRectangleObject::getBatchState(ofxRectangleBatchState &oState)
+{
+  memset(&oState, 0, sizeof(oState));
+  ofxShapeRenderer::getBlendState(oState.blend);
+  glGetFloatv(GL_LINE_WIDTH, &oState.lineWidth);
+}
+
+//Draws all queued rectangles, one call per run of triangles or lines, with the blend state they were queued under.
+//Vertices are already in eye space, so the modelview is reset.
+void ofxRectangleObject::flushRectangles()
+{
+  if(batchIndices.empty()) return;
+  
+  if(!batchVbo){
+    glGenBuffers(1, &batchVbo);
+    glGenBuffers(1, &batchIbo);
+  }
+  
+  int numVerts = batchColors.size();
+  glBindBuffer(GL_ARRAY_BUFFER, batchVbo);
+  glBufferData(GL_ARRAY_BUFFER, numVerts*(3*sizeof(float) + sizeof(ofColor)), NULL, GL_STREAM_DRAW);
+  glBufferSubData(GL_ARRAY_BUFFER, 0, numVerts*3*sizeof(float), &batchVertices[0]);
+  glBufferSubData(GL_ARRAY_BUFFER, numVerts*3*sizeof(float), numVerts*sizeof(ofColor), &batchColors[0]);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, batchIbo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, batchIndices.size()*sizeof(GLuint), &batchIndices[0], GL_STREAM_DRAW);
+  
+  glPushAttrib(GL_COLOR_BUFFER_BIT | GL_LINE_BIT);
+  ofxShapeRenderer::setBlendState(batchState.blend);
+  glLineWidth(batchState.lineWidth);
+  
+  glMatrixMode(GL_MODELVIEW);
+  glPushMatrix();
+  glLoadIdentity();
+  glNormal3f(0, 0, 1);
+  
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(3, GL_FLOAT, 0, 0);
+  glEnableClientState(GL_COLOR_ARRAY);
+  glColorPointer(4, GL_UNSIGNED_BYTE, 0, (GLvoid *)(numVerts*3*sizeof(float)));
+  
+  for(unsigned int i=0; i < batchRuns.size(); i++)
+    glDrawElements(batchRuns[i].mode, batchRuns[i].count, GL_UNSIGNED_INT, (GLvoid *)(batchRuns[i].first*sizeof(GLuint)));
+  
+  glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  glPopMatrix();
+  glPopAttrib();
+  
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  
+  batchVertices.clear();
+  batchColors.clear();
+  batchIndices.clear();
+  batchRuns.clear();
+}
@@ -2,6 +2,14 @@
  ofxPolygonObject
  
  Simple ofxObject that draws a rectangle.
+ Rectangles don't draw one by one. render() transforms the corners on the CPU and appends them
+ to a buffer shared by all rectangles, which goes out in as few draw calls as possible when something
+ else needs to draw (see ofxObject::flushBatch()), or when the blend func or line width changes.
+ The batch is drawn with the blend state its rectangles were queued under.
+ Strokes are lines at the current line width, like ofDrawRectangle(). With isStrokeScaled, they're
+ drawn as quads strokeWidth units wide instead, so they scale with the object.
+ Rectangles with a shader fall back to drawing on their own.
+ Setting cornerRadius draws the rectangle with ofxShapeRenderer instead.
  
  Soso OpenFrameworks Addon
  Copyright (C) 2012 Sosolimited
@@ -25,6 +33,21 @@
 
 #include "ofxObject.h"
 
+//GL state the batch is drawn with.
+struct ofxRectangleBatchState
+{
+  GLint           blend[7];         //enabled, src/dst rgb, src/dst alpha, rgb/alpha equations
+  GLfloat         lineWidth;
+};
+
+//Consecutive indices drawn with one primitive.
+struct ofxRectangleRun
+{
+  GLenum          mode;
+  int             first;
+  int             count;
+};
+
 class ofxRectangleObject : public ofxObject
 {
 public:
@@ -32,13 +55,39 @@ public:
 	~ofxRectangleObject();
 	
 	void						render();
+  bool            isBatchable();
 	void						setCentered(bool iB);
   
+  static void     enableBatching(bool iEnable);
+  static void     flushRectangles();
+  
+protected:
+  void            renderImmediate();
+  GLuint          appendCorners(const float *iCorners, int iNumCorners, const ofColor &iColor);
+  static void     appendIndices(GLenum iMode, const GLuint *iIndices, int iNumIndices);
+  void            appendQuad(float iX0, float iY0, float iX1, float iY1, const ofColor &iColor);
+  void            appendOutline(float iX0, float iY0, float iX1, float iY1, const ofColor &iColor);
+  void            appendFrame(float iX0, float iY0, float iX1, float iY1, float iWidth, const ofColor &iColor);
+  static void     getBatchState(ofxRectangleBatchState &oState);
+  
 public:
 	ofVec2f					dimensions;
 	bool						isCentered;
 	bool						isFilled;
 	float						strokeAlpha, fillAlpha;
+  float           strokeWidth;      //used with isStrokeScaled or cornerRadius
+  bool            isStrokeScaled;   //draw strokes as quads strokeWidth units wide, instead of lines
+  float           cornerRadius;     //drawn with ofxShapeRenderer when > 0
+  
+protected:
+  static bool             isBatchingEnabled;
+  static vector<float>    batchVertices;    //eye space x, y, z
+  static vector<ofColor>  batchColors;
+  static vector<GLuint>   batchIndices;
+  static vector<ofxRectangleRun>  batchRuns;
+  static ofxRectangleBatchState   batchState;
+  static GLuint           batchVbo,
+                          batchIbo;
   
 };
 
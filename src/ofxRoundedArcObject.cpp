@@ -8,8 +8,15 @@
  */
 
 #include "ofxRoundedArcObject.h"
+#include "ofxShapeRenderer.h"
 //#include "ofxArcObject.h"
 
+vector<float> ofxRoundedArcObject::wallTemplate;
+vector<float> ofxRoundedArcObject::capTemplate;
+
+#define OF_CORNER_WALL_POINTS   10    //0 to 9PI/16
+#define OF_CORNER_CAP_POINTS    5     //0 to PI/2
+
 //start and end angles in degrees (converted to radians internally)
 ofxRoundedArcObject::ofxRoundedArcObject(float iOuterRadius, float iInnerRadius, float iStartAngle, float iEndAngle)
 :ofxArcObject(iOuterRadius,  iInnerRadius,  iStartAngle,  iEndAngle)
@@ -17,16 +24,56 @@ ofxRoundedArcObject::ofxRoundedArcObject(float iOuterRadius, float iInnerRadius,
 	//inner rounded corner
 	curveRadius = 5;
 	
+	height = 60;
+	
+	cornerVbo = 0;
+	cornerOuterRadius = cornerInnerRadius = cornerCurveRadius = cornerHeight = -1;
+	cornerStartAngle = cornerEndAngle = 0;
+	
+	//the unit templates are shared by all rounded arcs
+	if(wallTemplate.empty()){
+		for(int i=0; i < OF_CORNER_WALL_POINTS; i++){
+			wallTemplate.push_back(cos(i*PI/16.0f));
+			wallTemplate.push_back(sin(i*PI/16.0f));
+		}
+		for(int i=0; i < OF_CORNER_CAP_POINTS; i++){
+			capTemplate.push_back(cos(i*PI/8.0f));
+			capTemplate.push_back(sin(i*PI/8.0f));
+		}
+	}
+	
+	updateCorners();
+}
+
+ofxRoundedArcObject::~ofxRoundedArcObject(){
+	if(cornerVbo) glDeleteBuffers(1, &cornerVbo);
+}
+
+/*
+ void ofxRoundedArcObject::setResolution(int iRes)
+ {
+ 
+ resolution = iRes;
+ 
+ }
+ */
+
+//Works out where the corner circles sit for the arc's current shape. Returns true if anything moved.
+bool ofxRoundedArcObject::updateCorners()
+{
+	if((outerRadius == cornerOuterRadius) && (innerRadius == cornerInnerRadius) && (curveRadius == cornerCurveRadius) &&
+	   (startAngle == cornerStartAngle) && (endAngle == cornerEndAngle) && (height == cornerHeight))
+		return false;
+	
 	//where the inner corner circles are located
 	newInnerRadius = innerRadius + curveRadius;
-  
-	deltaAngle = atan2(curveRadius, iInnerRadius + curveRadius);
+	
+	deltaAngle = atan2(curveRadius, innerRadius + curveRadius);
 	curveRadius2 = deltaAngle*outerRadius / (1 + deltaAngle);
 	
 	//where the outer corner circles are located
 	newOuterRadius = outerRadius - curveRadius2;
 	
-	
 	newStartAngle = startAngle + deltaAngle;
 	newEndAngle = endAngle - deltaAngle;
 	
@@ -35,224 +82,122 @@ ofxRoundedArcObject::ofxRoundedArcObject(float iOuterRadius, float iInnerRadius,
 	circPos3.set(newInnerRadius*cos(newEndAngle), newInnerRadius*sin(newEndAngle), 0);
 	circPos4.set(newOuterRadius*cos(newEndAngle), newOuterRadius*sin(newEndAngle), 0);
 	
-	/*
-   static int numArcs = 0;
-   id = numArcs++;
-   
-   resolution = 100;
-   
-   outerRadius = iOuterRadius;
-   innerRadius = iInnerRadius;
-   
-   //add -90 offset if you want 0 degrees at 12 o'clock
-   startAngle = ofDegToRad(iStartAngle);
-   endAngle = ofDegToRad(iEndAngle);
-	 */
-	
-	height = 60;
+	cornerOuterRadius = outerRadius;
+	cornerInnerRadius = innerRadius;
+	cornerCurveRadius = curveRadius;
+	cornerStartAngle = startAngle;
+	cornerEndAngle = endAngle;
+	cornerHeight = height;
 	
+	return true;
 }
 
-ofxRoundedArcObject::~ofxRoundedArcObject(){
-  
+//Writes the corner strips by rotating the unit templates to each corner:
+//start wall, end wall, start cap, end cap, each a triangle strip of position + normal vertices.
+void ofxRoundedArcObject::buildCornerBuffer()
+{
+	int numVerts = 4*OF_CORNER_WALL_POINTS + 4*OF_CORNER_CAP_POINTS;
+	cornerData.resize(6*numVerts);
+	float *v = &cornerData[0];
+	
+	float cs = cos(newStartAngle), ss = sin(newStartAngle);
+	float ce = cos(newEndAngle), se = sin(newEndAngle);
+	
+	//corner circle extrusions, facing out from the corner circles.
+	//The start wall sweeps PI/2 from newStartAngle + PI, the end wall sweeps 9PI/16 from newEndAngle + 7PI/16.
+	float c7 = cos(7*PI/16.0f), s7 = sin(7*PI/16.0f);
+	float bases[2][2] = {{-cs, -ss}, {ce*c7 - se*s7, se*c7 + ce*s7}};
+	ofVec3f centers[2] = {circPos1, circPos3};
+	int counts[2] = {OF_CORNER_WALL_POINTS - 1, OF_CORNER_WALL_POINTS};
+	
+	for(int w=0; w < 2; w++){
+		for(int i=0; i < OF_CORNER_WALL_POINTS; i++){
+			//the start wall stops at PI/2, so its last point repeats (a degenerate triangle)
+			int k = MIN(i, counts[w] - 1);
+			float nx = bases[w][0]*wallTemplate[2*k] - bases[w][1]*wallTemplate[2*k + 1];
+			float ny = bases[w][1]*wallTemplate[2*k] + bases[w][0]*wallTemplate[2*k + 1];
+			float x = centers[w].x + curveRadius*nx;
+			float y = centers[w].y + curveRadius*ny;
+			
+			v[0] = x;  v[1] = y;  v[2] = height;  v[3] = nx;  v[4] = ny;  v[5] = 0;
+			v[6] = x;  v[7] = y;  v[8] = 0;       v[9] = nx;  v[10] = ny; v[11] = 0;
+			v += 12;
+		}
+	}
+	
+	//curved caps on the top face, between the inner and outer corner circles
+	for(int i=0; i < OF_CORNER_CAP_POINTS; i++){
+		float co = capTemplate[2*i], so = capTemplate[2*i + 1];
+		
+		//start: inner circle from newStartAngle + PI forwards, outer circle from newStartAngle backwards
+		v[0] = circPos1.x + curveRadius*(-cs*co + ss*so);
+		v[1] = circPos1.y + curveRadius*(-ss*co - cs*so);
+		v[6] = circPos2.x + curveRadius2*(cs*co + ss*so);
+		v[7] = circPos2.y + curveRadius2*(ss*co - cs*so);
+		v[2] = v[8] = height;
+		v[3] = v[4] = v[9] = v[10] = 0;
+		v[5] = v[11] = 1;
+		
+		//end: inner circle from newEndAngle + PI backwards, outer circle from newEndAngle forwards
+		float *e = v + 12*OF_CORNER_CAP_POINTS;
+		e[0] = circPos3.x + curveRadius*(-ce*co - se*so);
+		e[1] = circPos3.y + curveRadius*(-se*co + ce*so);
+		e[6] = circPos4.x + curveRadius2*(ce*co - se*so);
+		e[7] = circPos4.y + curveRadius2*(se*co + ce*so);
+		e[2] = e[8] = height;
+		e[3] = e[4] = e[9] = e[10] = 0;
+		e[5] = e[11] = 1;
+		
+		v += 12;
+	}
+	
+	if(!cornerVbo) glGenBuffers(1, &cornerVbo);
+	glBindBuffer(GL_ARRAY_BUFFER, cornerVbo);
+	glBufferData(GL_ARRAY_BUFFER, cornerData.size()*sizeof(float), &cornerData[0], GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
-/*
- void ofxRoundedArcObject::setResolution(int iRes)
- {
- 
- resolution = iRes;
- 
- }
- */
-
 void ofxRoundedArcObject::render()
 {
+  //the shape shader rounds all four corners by curveRadius
+  if (isBatchable()) {
+    queueBatch(&ofxShapeRenderer::flush);
+    ofxShapeRenderer::addArc(matrix, outerRadius, innerRadius, startAngle, endAngle, curveRadius,
+                             isGradientEnabled ? color1 : drawMaterial->color,
+                             isGradientEnabled ? color2 : drawMaterial->color, height);
+    return;
+  }
   
-	if (renderDirty) {
-		
-		// PEND PORT - v2.59 - opengles
-		glDeleteLists (displayList, 1);
-		glNewList(displayList, GL_COMPILE_AND_EXECUTE);
-    
-		//corner circle extrusions
-		glBegin(GL_QUAD_STRIP);
-		for (float i = newStartAngle + PI; i <= newStartAngle + 3*PI/2 ; i+= PI/16.0f) {
-			//glColor3f((i-(newStartAngle + PI))/PI/2.0, 0, 1-(i-(newStartAngle + PI))/PI/2.0);
-			glNormal3f(cos(i), sin(i), 0);
-			glVertex3f(circPos1.x + curveRadius*cos(i), circPos1.y + curveRadius*sin(i), height);
-			glVertex3f(circPos1.x + curveRadius*cos(i), circPos1.y + curveRadius*sin(i), 0);
-		}
-		glEnd();
-		
-		glBegin(GL_QUAD_STRIP);
-		for (float i = newEndAngle +7*PI/16; i <= newEndAngle + PI ; i+= PI/16.0f) {
-			//glColor3f((i-(newEndAngle + PI/2.0))/PI/2.0, 0, 1-(i-(newEndAngle + PI/2.0))/PI/2.0);
-			glNormal3f(cos(i), sin(i), 0);
-			glVertex3f(circPos3.x + curveRadius*cos(i), circPos3.y + curveRadius*sin(i), height);
-			glVertex3f(circPos3.x + curveRadius*cos(i), circPos3.y + curveRadius*sin(i), 0);
-		}
-		glEnd();
-    
-		/*
-     glBegin(GL_QUAD_STRIP);
-     for (float i = 0 ; i <= 2.0*PI ; i+= PI/4.0f) {
-     glNormal3f(cos(i), sin(i), 0);
-     glVertex3f(circPos2.x + curveRadius2*cos(i), circPos2.y + curveRadius2*sin(i), height);
-     glVertex3f(circPos2.x + curveRadius2*cos(i), circPos2.y + curveRadius2*sin(i), 0);
-     
-     }
-     glEnd();
-     glBegin(GL_QUAD_STRIP);
-     for (float i = 0 ; i <= 2.0*PI ; i+= PI/4.0f) {
-     glNormal3f(cos(i), sin(i), 0);
-     glVertex3f(circPos4.x + curveRadius2*cos(i), circPos4.y + curveRadius2*sin(i), height);
-     glVertex3f(circPos4.x + curveRadius2*cos(i), circPos4.y + curveRadius2*sin(i), 0);
-     
-     
-     }
-     glEnd();
-     
-		 
-     
-     //beginning and end caps
-     
-     glBegin(GL_QUADS);
-     
-     glNormal3f(cos(startAngle+PI/2), sin(startAngle+PI/2), 0);
-     glVertex3f((newInnerRadius)*cos(startAngle), (newInnerRadius)*sin(startAngle), height);
-     glVertex3f((newOuterRadius)*cos(startAngle), (newOuterRadius)*sin(startAngle), height);
-     glVertex3f((newOuterRadius)*cos(startAngle), (newOuterRadius)*sin(startAngle), 0);
-     glVertex3f((newInnerRadius)*cos(startAngle), (newInnerRadius)*sin(startAngle), 0);
-     
-     
-     glNormal3f(cos(startAngle-PI/2), sin(startAngle-PI/2), 0);
-     glVertex3f((newInnerRadius)*cos(startAngle), (newInnerRadius)*sin(startAngle), height);
-     glVertex3f((newOuterRadius)*cos(startAngle), (newOuterRadius)*sin(startAngle), height);
-     glVertex3f((newOuterRadius)*cos(startAngle), (newOuterRadius)*sin(startAngle), 0);
-     glVertex3f((newInnerRadius)*cos(startAngle), (newInnerRadius)*sin(startAngle), 0);
-     
-     glEnd();
-     */
-		
-    
-		
-		int k = 0;
-		float angleInc = M_TWO_PI/(float)resolution;
-		float angle = newStartAngle;
-		
-		//inner side
-		glBegin(GL_QUAD_STRIP);
-		
-		while(angle < newEndAngle){
-			glNormal3f(cos(angle+PI), sin(angle+PI), 0);
-			glVertex3f(innerRadius * cos(angle), innerRadius * sin(angle), 0);
-			glVertex3f(innerRadius * cos(angle), innerRadius * sin(angle), height);
-			
-			angle += angleInc;
-		}
-		//finish it
-		glNormal3f(cos(angle+PI), sin(angle+PI), 0);
-		glVertex3f(innerRadius * cos(newEndAngle), innerRadius * sin(newEndAngle), 0);
-		glVertex3f(innerRadius * cos(newEndAngle), innerRadius * sin(newEndAngle), height);
-		glVertex3f(innerRadius * cos(newEndAngle+PI/360.0), innerRadius * sin(newEndAngle+PI/360.0), 0);
-		glVertex3f(innerRadius * cos(newEndAngle+PI/360.0), innerRadius * sin(newEndAngle+PI/360.0), height);
-		
-		glEnd();
-		
-		/*
-     //outer side
-     glBegin(GL_QUAD_STRIP);
-     
-     while(angle < newEndAngle){
-     glNormal3f(cos(angle), sin(angle), 0);
-     glVertex3f(outerRadius * cos(angle), outerRadius * sin(angle), 0);
-     glVertex3f(outerRadius * cos(angle), outerRadius * sin(angle), height);
-     
-     angle += angleInc;
-     }
-     //finish it
-     glNormal3f(cos(newEndAngle), sin(newEndAngle), 0);
-     glVertex3f(outerRadius * cos(newEndAngle), outerRadius * sin(newEndAngle), 0);
-     glVertex3f(outerRadius * cos(newEndAngle), outerRadius * sin(newEndAngle), height);
-     
-     glEnd();
-     */
-		/*
-     //trapezoids filling in missing part between corners
-     glBegin(GL_QUADS);
-     glNormal3f(0,0,1);
-     glVertex3f((innerRadius )*cos(startAngle), (innerRadius + curveRadius)*sin(startAngle), 0);
-     glVertex3f((outerRadius)*cos(startAngle), (outerRadius - curveRadius2)*sin(startAngle), 0);
-     glVertex3f((outerRadius)*cos(newStartAngle), (outerRadius)*sin(newStartAngle), 0);
-     glVertex3f((innerRadius )*cos(newStartAngle), (innerRadius)*sin(newStartAngle), 0);
-     
-     glVertex3f((innerRadius )*cos(newEndAngle), (innerRadius)*sin(newEndAngle), 0);
-     glVertex3f((outerRadius )*cos(newEndAngle), (outerRadius)*sin(newEndAngle), 0);
-     glVertex3f((outerRadius - curveRadius2)*cos(endAngle), (outerRadius - curveRadius2)*sin(endAngle), 0);
-     glVertex3f((innerRadius + curveRadius)*cos(endAngle), (innerRadius + curveRadius)*sin(endAngle), 0);
-     
-     glEnd();
-     */
-		//BEGINNING & END curved strips
-		glBegin(GL_QUAD_STRIP);
-    
-		//1st curved part of button
-		for (float i = 0 ; i <= PI/2.0f ; i+= PI/8.0f) {
-			glNormal3f(0,0,1);
-      
-			//glColor3f(1,0,0);
-			glVertex3f(circPos1.x + curveRadius*cos(newStartAngle + PI + i), circPos1.y + curveRadius*sin(newStartAngle + PI + i), height);
-			//glColor3f(0,0,1);
-			glVertex3f(circPos2.x + curveRadius2*cos(newStartAngle - i), circPos2.y + curveRadius2*sin(newStartAngle - i), height);
-			
-		}
-		
-		glEnd();
-		
-		glBegin(GL_QUAD_STRIP);
-		
-		//end curved part of button
-		for (float i = 0 ; i <= PI/2.0f ; i+= PI/8.0f) {
-			glNormal3f(0,0,1);
-      
-			//glColor3f(0,1,0);
-			glVertex3f(circPos3.x + curveRadius*cos(newEndAngle + PI - i ), circPos3.y + curveRadius*sin(newEndAngle + PI - i), height);
-			//glColor3f(1,1,0);
-			glVertex3f(circPos4.x + curveRadius2*cos(newEndAngle + i), circPos4.y + curveRadius2*sin(newEndAngle + i), height);
-			
-		}
-		
-		glEnd();
-		
-		//main part of button
-		glBegin(GL_QUAD_STRIP);
-		//glColor4f(1,1,1,1);
-		angle = newStartAngle;
-		while(angle < newEndAngle){
-			glNormal3f(0,0,1);
-      
-			glVertex3f(innerRadius * cos(angle), innerRadius * sin(angle), height);
-			glVertex3f(outerRadius * cos(angle), outerRadius * sin(angle), height);
-			
-			angle += angleInc;
-		}
-		//finish it
-		glVertex3f(innerRadius * cos(newEndAngle), innerRadius * sin(newEndAngle), height);
-		glVertex3f(outerRadius * cos(newEndAngle), outerRadius * sin(newEndAngle), height);
-		
-		glEnd();
-    
-		glEndList();
-		
-		renderDirty = false;
-		
-	}	else {
-		
-		glCallList(displayList);
-		
+	updateLOD();
+	bool cornersDirty = updateCorners();
+	
+	if (newEndAngle <= newStartAngle) return;
+	
+	//inner side and main part of the button
+	updateMesh(newStartAngle, newEndAngle);
+	drawMesh(false);
+	
+	if (cornersDirty || !cornerVbo) buildCornerBuffer();
+	
+	GLsizei stride = 6*sizeof(float);
+	glBindBuffer(GL_ARRAY_BUFFER, cornerVbo);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glVertexPointer(3, GL_FLOAT, stride, 0);
+	
+	if (height > 0) {
+		glEnableClientState(GL_NORMAL_ARRAY);
+		glNormalPointer(GL_FLOAT, stride, (GLvoid *)(3*sizeof(float)));
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 2*OF_CORNER_WALL_POINTS);
+		glDrawArrays(GL_TRIANGLE_STRIP, 2*OF_CORNER_WALL_POINTS, 2*OF_CORNER_WALL_POINTS);
+		glDisableClientState(GL_NORMAL_ARRAY);
 	}
 	
+	glNormal3f(0, 0, 1);
+	glDrawArrays(GL_TRIANGLE_STRIP, 4*OF_CORNER_WALL_POINTS, 2*OF_CORNER_CAP_POINTS);
+	glDrawArrays(GL_TRIANGLE_STRIP, 4*OF_CORNER_WALL_POINTS + 2*OF_CORNER_CAP_POINTS, 2*OF_CORNER_CAP_POINTS);
+	
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
 }
 
 /*
@@ -1,7 +1,10 @@
 /*
  ofxRoundedArcObject
  
- Simple ofxObject that draws an arc.
+ Simple ofxObject that draws an arc with rounded corners.
+ The inner wall and top face share ofxArcObject's vertex buffer, so animating the angles only rewrites
+ the ends of the sweep. The corners are built from precomputed unit templates into a small buffer of
+ their own, rebuilt when the arc's shape changes.
  
  Soso OpenFrameworks Addon
  Copyright (C) 2012 Sosolimited
@@ -36,6 +39,10 @@ public:
 	//void						setStartAngle(float iAngle);
 	//void						setEndAngle(float iAngle);
 	
+protected:
+	bool						updateCorners();
+	void						buildCornerBuffer();
+	
 public:
 	float						curveRadius, curveRadius2;
 	float						newStartAngle;
@@ -47,6 +54,18 @@ public:
                   circPos2,
                   circPos3,
                   circPos4;
-	float						height;
 	
-};
+protected:
+	GLuint					cornerVbo;			//corner walls and caps, positions and normals interleaved
+	vector<float>		cornerData;
+	float						cornerOuterRadius,	//what the corners were last computed for
+                  cornerInnerRadius,
+                  cornerStartAngle,
+                  cornerEndAngle,
+                  cornerCurveRadius,
+                  cornerHeight;
+	
+	static vector<float>	wallTemplate,		//unit cos/sin offsets for the corner walls
+                        capTemplate;		//and the top face caps
+	
+};
\ No newline at end of file
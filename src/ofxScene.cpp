@@ -30,6 +30,9 @@ ofxScene::ofxScene(int w, int h)
 	sceneHeight = h;
 	
 	root = new ofxObject();
+	timeline = new ofxMessageTimeline();
+	clock = new ofxClock();
+	exporter = new ofxFrameExporter();
 	
 	isClearBackgroundOn = true;
 	backgroundColor.set(255,255,255,255);
@@ -99,6 +102,9 @@ ofxScene::ofxScene(int w, int h)
 // Destructor.
 ofxScene::~ofxScene(){
   delete root;
+  delete timeline;
+  delete exporter;
+  delete clock;
   //  delete defaultMaterial; //DEV: can't delete this or else my test crashes...
   delete sortedObjects;     //DEV: hopefully we can delete a double pointer like a normal pointer, like this.
   // how can i clear() this vector?
@@ -106,13 +112,75 @@ ofxScene::~ofxScene(){
   // how can i clear() this vector?
 }
 
+//Advances the scene's clock by a frame and updates to its time.
+void ofxScene::update()
+{
+	clock->update();
+	updateObjects();
+}
+
+//Updates to iTime, setting the scene's clock to it.
 void ofxScene::update(float iTime)
 {
+	clock->setTime(iTime);
+	updateObjects();
+}
+
+void ofxScene::updateObjects()
+{
+	float time = clock->getTime();
+	ofxClock::setCurrent(clock);
+  
+	//Objects hand new messages to this scene's timeline while they idle.
+	ofxObject::curTimeline = timeline;
+  
 	//This call to root's idle propagates down to all children in the tree.
-	root->idleBase(iTime);
+	root->idleBase(time);
   
 	//Updates all object's curTime, which is used for things like messages.
-	ofxObject::curTime = iTime;
+	ofxObject::curTime = time;
+  
+	//Evaluates the messages of all objects in one pass.
+	timeline->update(time);
+	ofxObject::curTimeline = NULL;
+}
+
+ofxMessageTimeline* ofxScene::getTimeline()
+{
+	return timeline;
+}
+
+ofxClock* ofxScene::getClock()
+{
+	return clock;
+}
+
+//Exports every frame drawn from now on. A frame rate of 0 uses the clock's fixed time step, or 30.
+bool ofxScene::startExport(string iPath, int iFormat, int iFrameRate)
+{
+	if(iFrameRate <= 0)
+		iFrameRate = clock->isFixedTimeStep() ? (int)(1.0/clock->getTimeStep() + 0.5) : 30;
+
+	return exporter->start(iPath, iFormat, iFrameRate);
+}
+
+void ofxScene::stopExport()
+{
+	exporter->stop();
+}
+
+ofxFrameExporter* ofxScene::getFrameExporter()
+{
+	return exporter;
+}
+
+//The scene takes ownership of iClock, and deletes the one it had.
+void ofxScene::setClock(ofxClock *iClock)
+{
+	if(!iClock || (iClock == clock)) return;
+
+	delete clock;
+	clock = iClock;
 }
 
 ofxObject* ofxScene::getRoot()
@@ -139,6 +207,9 @@ void ofxScene::draw()
     renderer->setupScreen();
   }
   
+  // Lets objects figure out their size on screen (e.g. for tessellation level of detail).
+  ofxObject::setProjection(renderer->getProjectionMatrix().getPtr(), sceneHeight);
+  
 	//Necessary for proper rendering of transparency.
 	ofEnableAlphaBlending();
   
@@ -191,6 +262,7 @@ void ofxScene::draw()
 		drawAlphaDepth();
 	else if(renderMode == RENDER_ALPHA_DEPTH_SORTED)
 		drawAlphaDepthSorted();
+  ofxObject::flushBatch();
   
   // Handle on top drawing objects.
   if (onTopDrawingEnabled) {
@@ -204,6 +276,7 @@ void ofxScene::draw()
       ofxObject *obj = onTopObjects[i];
       obj->draw(defaultMaterial, defaultMatrix, OF_RENDER_ALL, true);
     }
+    ofxObject::flushBatch();
     // Reset depth test if it's supposed to be true.
     if (isDepthTestOn){
       glEnable(GL_DEPTH_TEST);
@@ -212,6 +285,9 @@ void ofxScene::draw()
   
 	if(isScissorOn)
 		glDisable(GL_SCISSOR_TEST);
+  
+	if(exporter->isExporting())
+		exporter->capture();
 }
 
 void ofxScene::drawNormal()
@@ -223,9 +299,11 @@ void ofxScene::drawAlphaDepth()
 {
 	//First draw opaque objects.
 	root->draw(defaultMaterial, defaultMatrix, OF_RENDER_OPAQUE);
+	ofxObject::flushBatch();
 	//Disable depth buffer writing and draw transparent objects.
 	setDepthMask(false);
 	root->draw(defaultMaterial, defaultMatrix, OF_RENDER_TRANSPARENT);
+	ofxObject::flushBatch();
 	//Re-enable depth buffer writing.
 	setDepthMask(true);
 }
@@ -234,6 +312,7 @@ void ofxScene::drawAlphaDepthSorted()
 {
 	//Draw opaque objects
 	root->draw(defaultMaterial, defaultMatrix, OF_RENDER_OPAQUE);
+	ofxObject::flushBatch();
 	
 	//Disable depth buffer writing.
 	setDepthMask(false);
@@ -246,6 +325,7 @@ void ofxScene::drawAlphaDepthSorted()
 	for (int i=0; i < size; i++) {
 		sortedObjects[i]->draw(defaultMaterial, defaultMatrix, OF_RENDER_ALL, true);
 	}
+	ofxObject::flushBatch();
   
 	//Re-enable depth buffer writing.
 	setDepthMask(true);
@@ -15,6 +15,10 @@
  The owner of an ofxScene should call its update() and draw() methods once per frame. The update call propagates
  calls to the idle() method of every object in the tree. The draw() call propagates calls to the render() method
  of every object in the tree, among other things.
+ Scene time comes from the scene's ofxClock (see getClock()). update() advances the clock a frame, while update(iTime)
+ runs the scene on the time it's handed. For offline rendering, enable the clock's fixed time step and call update().
+ startExport() saves every frame the scene draws to disk, without waiting on the GPU or the disk (see ofxFrameExporter).
+ Call stopExport() while the window is still open; a scene deleted mid-export drops the frames still on the GPU.
  
  Soso OpenFrameworks Addon
  Copyright (C) 2012 Sosolimited
@@ -38,6 +42,8 @@
 
 #include "ofxObject.h"
 #include "ofxSosoRenderer.h"
+#include "ofxClock.h"
+#include "ofxFrameExporter.h"
 
 
 enum{
@@ -67,8 +73,15 @@ public:
 	ofxScene(int w, int h);
 	virtual ~ofxScene();
   
+	void					update();
 	void					update(float iTime);
 	ofxObject*		getRoot();
+	ofxMessageTimeline*	getTimeline();
+	ofxClock*			getClock();
+	void					setClock(ofxClock *iClock);
+	bool					startExport(string iPath, int iFormat=OF_EXPORT_PNG, int iFrameRate=0);
+	void					stopExport();
+	ofxFrameExporter*	getFrameExporter();
 	void					setRoot(ofxObject *iRoot);
 	void					draw();
 	void					drawNormal();
@@ -90,6 +103,11 @@ public:
 	void					setShadingModel(GLenum iModel);
 	int						getSceneWidth();
 	int						getSceneHeight();
+
+protected:
+	void					updateObjects();
+
+public:
 	ofVec4f				getBackgroundColor(); //LM 061312
 
   void          enableSetupScreen(bool iEnable);
@@ -121,6 +139,9 @@ private:
 	GLenum				shadingModel;
   
   ofxObject			*root;
+  ofxMessageTimeline	*timeline;
+  ofxClock			*clock;
+  ofxFrameExporter	*exporter;
 	ofBaseApp			*app;
   ofxObject			**onTopObjects;
   ofxObject			**sortedObjects;
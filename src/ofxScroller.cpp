@@ -6,6 +6,7 @@
 //
 
 #include "ofxScroller.h"
+#include "ofxClock.h"
 
 //----------------------------------------------------------------------------------
 // Class ofxScrollTransform
@@ -110,6 +111,9 @@ ofxScroller::ofxScroller(float iHeight) {
   // Top of scroller
   scrollPosition = 0;
   
+  // Scene time, for disable timers
+  time = ofxClock::getCurrentTime();
+  
   // Max scroll position.
   scrollHeight = iHeight;
   
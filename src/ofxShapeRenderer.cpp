@@ -0,0 +1,276 @@
+#include "ofxShapeRenderer.h"
+
+vector<ofxShapeRenderer::ofxShapeVertex> ofxShapeRenderer::vertices;
+vector<GLuint> ofxShapeRenderer::indices;
+GLuint ofxShapeRenderer::vbo = 0;
+GLuint ofxShapeRenderer::ibo = 0;
+GLint ofxShapeRenderer::blendState[7];
+ofShader* ofxShapeRenderer::shader = NULL;
+bool ofxShapeRenderer::isShaderFailed = false;
+GLint ofxShapeRenderer::localLoc = -1;
+GLint ofxShapeRenderer::paramsLoc = -1;
+GLint ofxShapeRenderer::extraLoc = -1;
+GLint ofxShapeRenderer::color2Loc = -1;
+
+#define OF_SHAPE_ARC    0
+#define OF_SHAPE_RECT   1
+
+static const char *shapeVertSource =
+"#version 120\n"
+"attribute vec2 localPos;\n"
+"attribute vec4 shapeParams;\n"
+"attribute vec3 shapeExtra;\n"
+"attribute vec4 color2;\n"
+"varying vec2 local;\n"
+"varying vec4 params;\n"
+"varying vec3 extra;\n"
+"varying vec4 col1;\n"
+"varying vec4 col2;\n"
+"void main(){\n"
+"  gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+"  local = localPos;\n"
+"  params = shapeParams;\n"
+"  extra = shapeExtra;\n"
+"  col1 = gl_Color;\n"
+"  col2 = color2;\n"
+"}\n";
+
+//Distances are negative inside. Shapes are eroded by the corner radius and grown back, which rounds their corners.
+static const char *shapeFragSource =
+"#version 120\n"
+"varying vec2 local;\n"
+"varying vec4 params;\n"
+"varying vec3 extra;\n"
+"varying vec4 col1;\n"
+"varying vec4 col2;\n"
+"const float TWO_PI = 6.2831853;\n"
+"float intersect(float a, float b){\n"
+"  vec2 w = vec2(a, b);\n"
+"  return min(max(w.x, w.y), 0.0) + length(max(w, 0.0));\n"
+"}\n"
+"void main(){\n"
+"  float k = extra.x;\n"
+"  float d, t;\n"
+"  if(extra.y < 0.5){\n"
+"    float r = length(local);\n"
+"    float ring = max(r - params.x, params.y - r) + k;\n"
+"    float sweep = params.w - params.z;\n"
+"    float rel = mod(atan(local.y, local.x) - params.z, TWO_PI);\n"
+"    if(sweep >= TWO_PI){\n"
+"      d = ring - k;\n"
+"      t = rel/TWO_PI;\n"
+"    }else{\n"
+"      float h = 0.5*sweep;\n"
+"      float c = params.z + h;\n"
+"      vec2 q = vec2(cos(c)*local.x + sin(c)*local.y, abs(cos(c)*local.y - sin(c)*local.x));\n"
+"      vec2 n = vec2(cos(h), sin(h));\n"
+"      float wedge = length(q - n*max(dot(q, n), 0.0))*sign(n.x*q.y - n.y*q.x) + k;\n"
+"      d = intersect(ring, wedge) - k;\n"
+"      t = (rel <= sweep) ? rel/sweep : ((rel - sweep < TWO_PI - rel) ? 1.0 : 0.0);\n"
+"    }\n"
+"  }else{\n"
+"    vec2 q = abs(local) - params.xy + k;\n"
+"    d = intersect(q.x, q.y) - k;\n"
+"    if(extra.z > 0.0) d = abs(d) - 0.5*extra.z;\n"
+"    t = clamp(0.5 + 0.5*local.x/params.x, 0.0, 1.0);\n"
+"  }\n"
+"  float coverage = clamp(0.5 - d/max(fwidth(d), 0.0001), 0.0, 1.0);\n"
+"  if(coverage <= 0.0) discard;\n"
+"  vec4 color = mix(col1, col2, t);\n"
+"  gl_FragColor = vec4(color.rgb, color.a*coverage);\n"
+"}\n";
+
+
+//Compiles the shape shader the first time it's needed. Returns false if it didn't compile.
+bool ofxShapeRenderer::isSupported()
+{
+  if(shader) return true;
+  if(isShaderFailed) return false;
+  return setupShader();
+}
+
+bool ofxShapeRenderer::setupShader()
+{
+  shader = new ofShader();
+  if(!shader->setupShaderFromSource(GL_VERTEX_SHADER, shapeVertSource) ||
+     !shader->setupShaderFromSource(GL_FRAGMENT_SHADER, shapeFragSource) ||
+     !shader->linkProgram()){
+    ofLog(OF_LOG_ERROR, "ofxShapeRenderer - couldn't compile the shape shader, falling back to meshes");
+    delete shader;
+    shader = NULL;
+    isShaderFailed = true;
+    return false;
+  }
+  
+  localLoc = shader->getAttributeLocation("localPos");
+  paramsLoc = shader->getAttributeLocation("shapeParams");
+  extraLoc = shader->getAttributeLocation("shapeExtra");
+  color2Loc = shader->getAttributeLocation("color2");
+  return true;
+}
+
+//Queues a ring sector. The quad only covers the sector's bounding box (plus a margin for anti-aliasing).
+void ofxShapeRenderer::addArc(float *iMatrix, float iOuterRadius, float iInnerRadius, float iStartAngle, float iEndAngle,
+                              float iCornerRadius, ofColor iColor1, ofColor iColor2, float iZ)
+{
+  if((iEndAngle <= iStartAngle) || (iOuterRadius <= 0)) return;
+  
+  float x0 = -iOuterRadius, y0 = -iOuterRadius, x1 = iOuterRadius, y1 = iOuterRadius;
+  
+  if(iEndAngle - iStartAngle < M_TWO_PI){
+    //bounds of the four end corners, plus every axis crossing inside the sweep
+    float c0 = cos(iStartAngle), s0 = sin(iStartAngle), c1 = cos(iEndAngle), s1 = sin(iEndAngle);
+    x0 = x1 = iInnerRadius*c0;
+    y0 = y1 = iInnerRadius*s0;
+    float px[3] = {iOuterRadius*c0, iInnerRadius*c1, iOuterRadius*c1};
+    float py[3] = {iOuterRadius*s0, iInnerRadius*s1, iOuterRadius*s1};
+    for(int i=0; i < 3; i++){
+      x0 = MIN(x0, px[i]);  x1 = MAX(x1, px[i]);
+      y0 = MIN(y0, py[i]);  y1 = MAX(y1, py[i]);
+    }
+    for(int q = (int)ceil(iStartAngle/HALF_PI); q*HALF_PI < iEndAngle; q++){
+      switch(((q % 4) + 4) % 4){
+        case 0: x1 = iOuterRadius; break;
+        case 1: y1 = iOuterRadius; break;
+        case 2: x0 = -iOuterRadius; break;
+        case 3: y0 = -iOuterRadius; break;
+      }
+    }
+  }
+  
+  //room for the anti-aliased fringe
+  float margin = MAX(1.0f, 0.02f*iOuterRadius);
+  float params[4] = {iOuterRadius, iInnerRadius, iStartAngle, MIN(iEndAngle, iStartAngle + (float)M_TWO_PI)};
+  float extra[3] = {MIN(iCornerRadius, 0.5f*(iOuterRadius - iInnerRadius)), OF_SHAPE_ARC, 0};
+  addQuad(iMatrix, x0 - margin, y0 - margin, x1 + margin, y1 + margin, iZ, params, extra, iColor1, iColor2);
+}
+
+void ofxShapeRenderer::addRoundedRect(float *iMatrix, float iX, float iY, float iW, float iH, float iCornerRadius,
+                                      ofColor iColor1, ofColor iColor2, float iStrokeWidth)
+{
+  if((iW <= 0) || (iH <= 0)) return;
+  
+  //shape space is centered on the rectangle
+  float hw = 0.5f*iW, hh = 0.5f*iH;
+  float m[16];
+  memcpy(m, iMatrix, 16*sizeof(float));
+  m[12] += iMatrix[0]*(iX + hw) + iMatrix[4]*(iY + hh);
+  m[13] += iMatrix[1]*(iX + hw) + iMatrix[5]*(iY + hh);
+  m[14] += iMatrix[2]*(iX + hw) + iMatrix[6]*(iY + hh);
+  
+  float margin = MAX(1.0f, 0.02f*MAX(hw, hh)) + 0.5f*iStrokeWidth;
+  float params[4] = {hw, hh, 0, 0};
+  float extra[3] = {MIN(iCornerRadius, MIN(hw, hh)), OF_SHAPE_RECT, iStrokeWidth};
+  addQuad(m, -hw - margin, -hh - margin, hw + margin, hh + margin, 0, params, extra, iColor1, iColor2);
+}
+
+void ofxShapeRenderer::addQuad(float *iMatrix, float iX0, float iY0, float iX1, float iY1, float iZ, const float *iParams,
+                               const float *iExtra, const ofColor &iColor1, const ofColor &iColor2)
+{
+  //shapes queued under a different blend state go out first
+  GLint blend[7];
+  getBlendState(blend);
+  if(!indices.empty() && (memcmp(blend, blendState, sizeof(blend)) != 0)) flush();
+  memcpy(blendState, blend, sizeof(blend));
+  
+  GLuint first = vertices.size();
+  vertices.resize(first + 4);
+  
+  float corners[8] = {iX0, iY0,  iX1, iY0,  iX1, iY1,  iX0, iY1};
+  for(int i=0; i < 4; i++){
+    ofxShapeVertex &v = vertices[first + i];
+    float x = corners[2*i], y = corners[2*i + 1];
+    v.pos[0] = iMatrix[0]*x + iMatrix[4]*y + iMatrix[8]*iZ + iMatrix[12];
+    v.pos[1] = iMatrix[1]*x + iMatrix[5]*y + iMatrix[9]*iZ + iMatrix[13];
+    v.pos[2] = iMatrix[2]*x + iMatrix[6]*y + iMatrix[10]*iZ + iMatrix[14];
+    v.local[0] = x;
+    v.local[1] = y;
+    memcpy(v.params, iParams, 4*sizeof(float));
+    memcpy(v.extra, iExtra, 3*sizeof(float));
+    v.color1 = iColor1;
+    v.color2 = iColor2;
+  }
+  
+  GLuint quad[6] = {first, first+1, first+2,  first, first+2, first+3};
+  indices.insert(indices.end(), quad, quad + 6);
+}
+
+void ofxShapeRenderer::getBlendState(GLint oBlend[7])
+{
+  oBlend[0] = glIsEnabled(GL_BLEND);
+  glGetIntegerv(GL_BLEND_SRC_RGB, &oBlend[1]);
+  glGetIntegerv(GL_BLEND_DST_RGB, &oBlend[2]);
+  glGetIntegerv(GL_BLEND_SRC_ALPHA, &oBlend[3]);
+  glGetIntegerv(GL_BLEND_DST_ALPHA, &oBlend[4]);
+  glGetIntegerv(GL_BLEND_EQUATION_RGB, &oBlend[5]);
+  glGetIntegerv(GL_BLEND_EQUATION_ALPHA, &oBlend[6]);
+}
+
+void ofxShapeRenderer::setBlendState(const GLint iBlend[7])
+{
+  if(iBlend[0]) glEnable(GL_BLEND);
+  else glDisable(GL_BLEND);
+  glBlendFuncSeparate(iBlend[1], iBlend[2], iBlend[3], iBlend[4]);
+  glBlendEquationSeparate(iBlend[5], iBlend[6]);
+}
+
+//Draws every queued shape with one call, with the blend state they were queued under.
+//Vertices are already in eye space, so the modelview is reset.
+void ofxShapeRenderer::flush()
+{
+  if(indices.empty() || !isSupported()){
+    vertices.clear();
+    indices.clear();
+    return;
+  }
+  
+  if(!vbo){
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ibo);
+  }
+  
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  glBufferData(GL_ARRAY_BUFFER, vertices.size()*sizeof(ofxShapeVertex), &vertices[0], GL_STREAM_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size()*sizeof(GLuint), &indices[0], GL_STREAM_DRAW);
+  
+  glPushAttrib(GL_COLOR_BUFFER_BIT);
+  setBlendState(blendState);
+  
+  glMatrixMode(GL_MODELVIEW);
+  glPushMatrix();
+  glLoadIdentity();
+  
+  shader->begin();
+  
+  GLsizei stride = sizeof(ofxShapeVertex);
+  glEnableClientState(GL_VERTEX_ARRAY);
+  glVertexPointer(3, GL_FLOAT, stride, (GLvoid *)offsetof(ofxShapeVertex, pos));
+  glEnableClientState(GL_COLOR_ARRAY);
+  glColorPointer(4, GL_UNSIGNED_BYTE, stride, (GLvoid *)offsetof(ofxShapeVertex, color1));
+  
+  GLint locs[4] = {localLoc, paramsLoc, extraLoc, color2Loc};
+  for(int i=0; i < 4; i++)
+    if(locs[i] >= 0) glEnableVertexAttribArray(locs[i]);
+  if(localLoc >= 0) glVertexAttribPointer(localLoc, 2, GL_FLOAT, GL_FALSE, stride, (GLvoid *)offsetof(ofxShapeVertex, local));
+  if(paramsLoc >= 0) glVertexAttribPointer(paramsLoc, 4, GL_FLOAT, GL_FALSE, stride, (GLvoid *)offsetof(ofxShapeVertex, params));
+  if(extraLoc >= 0) glVertexAttribPointer(extraLoc, 3, GL_FLOAT, GL_FALSE, stride, (GLvoid *)offsetof(ofxShapeVertex, extra));
+  if(color2Loc >= 0) glVertexAttribPointer(color2Loc, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, (GLvoid *)offsetof(ofxShapeVertex, color2));
+  
+  glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
+  
+  for(int i=0; i < 4; i++)
+    if(locs[i] >= 0) glDisableVertexAttribArray(locs[i]);
+  glDisableClientState(GL_COLOR_ARRAY);
+  glDisableClientState(GL_VERTEX_ARRAY);
+  
+  shader->end();
+  glPopMatrix();
+  glPopAttrib();
+  
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  
+  vertices.clear();
+  indices.clear();
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+/*
+ofxShapeRenderer
+
+Draws circles, rings, arcs and rounded rectangles as a single quad each. The outline is evaluated
+analytically per pixel in a fragment shader (a signed distance to the shape), so edges stay smooth
+and anti-aliased at any size with just 4 vertices per shape.
+Shapes are queued with their object's matrix and drawn together in one call on flush(), using the same
+batching hook as ofxRectangleObject (see ofxObject::flushBatch()). Objects use it when their shape
+shader is enabled, e.g. ofxCircleObject::enableShapeShader().
+Each batch is drawn with the blend state its shapes were queued under; a change of blend state flushes it.
+Pixels outside a shape are discarded, so the quads' corners don't write depth.
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF 
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "ofxObject.h"
+
+class ofxShapeRenderer{
+  
+public:
+  //angles in radians, iMatrix is the object's modelview matrix
+  static void     addArc(float *iMatrix, float iOuterRadius, float iInnerRadius, float iStartAngle, float iEndAngle,
+                         float iCornerRadius, ofColor iColor1, ofColor iColor2, float iZ=0);
+  //iStrokeWidth of 0 fills the rectangle
+  static void     addRoundedRect(float *iMatrix, float iX, float iY, float iW, float iH, float iCornerRadius,
+                                 ofColor iColor1, ofColor iColor2, float iStrokeWidth=0);
+  static void     flush();
+  static bool     isSupported();
+  
+  //enabled, src/dst rgb, src/dst alpha, rgb/alpha equations
+  static void     getBlendState(GLint oBlend[7]);
+  static void     setBlendState(const GLint iBlend[7]);
+  
+protected:
+  static void     addQuad(float *iMatrix, float iX0, float iY0, float iX1, float iY1, float iZ, const float *iParams,
+                          const float *iExtra, const ofColor &iColor1, const ofColor &iColor2);
+  static bool     setupShader();
+  
+protected:
+  struct ofxShapeVertex{
+    float         pos[3];     //eye space
+    float         local[2];   //shape space
+    float         params[4];  //arcs: outer radius, inner radius, start angle, end angle. rects: half width, half height
+    float         extra[3];   //corner radius, shape type, stroke width
+    ofColor       color1,
+                  color2;
+  };
+  
+  static vector<ofxShapeVertex> vertices;
+  static vector<GLuint>         indices;
+  static GLuint                 vbo,
+                                ibo;
+  static GLint                  blendState[7];    //of the queued shapes
+  static ofShader               *shader;
+  static bool                   isShaderFailed;
+  static GLint                  localLoc,
+                                paramsLoc,
+                                extraLoc,
+                                color2Loc;
+  
+};
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "ofxSosoThreadPool.h"
+
+ofxSosoThreadPool::ofxSosoThreadPool(int iNumThreads)
+{
+	task = NULL;
+	numTasks = 0;
+	nextTask = 0;
+	numBusy = 0;
+	generation = 0;
+	isStopping = false;
+
+	startWorkers(iNumThreads - 1);
+}
+
+ofxSosoThreadPool::~ofxSosoThreadPool()
+{
+	stopWorkers();
+}
+
+//iNumThreads counts the calling thread, so 1 means no workers.
+void ofxSosoThreadPool::setNumThreads(int iNumThreads)
+{
+	if(iNumThreads < 1) iNumThreads = 1;
+	if(iNumThreads == getNumThreads()) return;
+
+	stopWorkers();
+	startWorkers(iNumThreads - 1);
+}
+
+//Calls iTask(i) for every i in [0, iNumTasks) and waits for all of them to finish.
+void ofxSosoThreadPool::run(int iNumTasks, const std::function<void(int)> &iTask)
+{
+	if(iNumTasks <= 0) return;
+
+	if(workers.empty() || (iNumTasks == 1)){
+		for(int i = 0; i < iNumTasks; i++)
+			iTask(i);
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		task = &iTask;
+		numTasks = iNumTasks;
+		nextTask = 0;
+		numBusy = (int)workers.size();
+		generation++;
+	}
+	wake.notify_all();
+
+	runTasks();
+
+	//the task list stays valid until every worker has checked back in
+	std::unique_lock<std::mutex> lock(mutex);
+	done.wait(lock, [this]{ return numBusy == 0; });
+	task = NULL;
+}
+
+void ofxSosoThreadPool::startWorkers(int iNumWorkers)
+{
+	isStopping = false;
+	for(int i = 0; i < iNumWorkers; i++)
+		workers.push_back(std::thread(&ofxSosoThreadPool::workerLoop, this, generation));
+}
+
+void ofxSosoThreadPool::stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isStopping = true;
+	}
+	wake.notify_all();
+
+	for(unsigned int i = 0; i < workers.size(); i++)
+		workers[i].join();
+	workers.clear();
+}
+
+void ofxSosoThreadPool::workerLoop(unsigned int iGeneration)
+{
+	unsigned int seen = iGeneration;
+	while(true){
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			wake.wait(lock, [this, seen]{ return isStopping || (generation != seen); });
+			if(isStopping) return;
+			seen = generation;
+		}
+
+		runTasks();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			numBusy--;
+		}
+		done.notify_one();
+	}
+}
+
+void ofxSosoThreadPool::runTasks()
+{
+	while(true){
+		int i = nextTask++;
+		if(i >= numTasks) break;
+		(*task)(i);
+	}
+}
@@ -0,0 +1,63 @@
+/*
+ofxSosoThreadPool
+
+A small fixed pool of worker threads for splitting a loop into independent tasks. run() hands out task
+indices to the workers and the calling thread, and returns once every task is done. Tasks must only write
+to data of their own, so which thread runs which task doesn't change the result.
+A pool created with one thread runs everything on the calling thread.
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF 
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <vector>
+
+class ofxSosoThreadPool
+{
+public:
+	ofxSosoThreadPool(int iNumThreads=1);
+	~ofxSosoThreadPool();
+
+	void							setNumThreads(int iNumThreads);
+	int								getNumThreads(){ return (int)workers.size() + 1; }
+	void							run(int iNumTasks, const std::function<void(int)> &iTask);
+
+protected:
+	void							startWorkers(int iNumWorkers);
+	void							stopWorkers();
+	void							workerLoop(unsigned int iGeneration);
+	void							runTasks();
+
+protected:
+	std::vector<std::thread>		workers;
+	std::mutex						mutex;
+	std::condition_variable			wake;
+	std::condition_variable			done;
+	const std::function<void(int)>	*task;
+	int								numTasks;
+	std::atomic<int>				nextTask;
+	int								numBusy;
+	unsigned int					generation;
+	bool							isStopping;
+};
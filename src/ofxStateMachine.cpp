@@ -7,6 +7,8 @@
 //
 
 #include "ofxStateMachine.h"
+#include "ofxClock.h"
+#include "ofxTask.h"
 
 ofxStateTransition::ofxStateTransition(ofxState *iStartState, ofxState *iEndState, float iDur)
 {
@@ -26,7 +28,7 @@ ofxStateMachine::ofxStateMachine()
   isTransitionBlocking = false;
   isVerbose = false;
   transitionClock = 0;
-  timeP = 0;  // Previous time.
+  timeP = ofxClock::getCurrentTime();  // Previous time.
   timeD = 0;  // Time difference.
 }
 
@@ -60,7 +62,7 @@ void ofxStateMachine::update(float iTime)
 		if(transitionClock >= curTransition->duration){
 			transitionClock = 0;
       // Set state to end state of transition.
-      curState = curTransition->endState;
+      setCurState(curTransition->endState);
       if(isVerbose) ofLogNotice("Current state is now "+curState->name+".");
       curTransition = NULL;
 		}
@@ -147,7 +149,7 @@ bool ofxStateMachine::gotoState(ofxState *iState)
 {
   // Init state for the first time.
   if(curState == NULL){
-    curState = iState;
+    setCurState(iState);
     if(isVerbose) ofLogNotice("State inited to "+curState->name+".");
   }else{
     // If transition blocking enabled, don't allow any transitions if already in transition.
@@ -171,9 +173,9 @@ bool ofxStateMachine::gotoState(ofxState *iState)
 
 bool ofxStateMachine::forceState(ofxState *iState)
 {
-  curState = iState;
   curTransition = NULL;
   transitionClock = 0;
+  setCurState(iState);
 }
 
 bool ofxStateMachine::gotoState(string iName)
@@ -245,3 +247,10 @@ float ofxStateMachine::getTransitionProgress()
 		return 1.0;
   
 }
+
+// Wakes tasks waiting for the new state.
+void ofxStateMachine::setCurState(ofxState *iState)
+{
+  curState = iState;
+  ofxTask::stateEntered(this, iState);
+}
@@ -59,6 +59,7 @@ public:
   
 private:
   void                startTransition(ofxStateTransition *iTransition);
+  void                setCurState(ofxState *iState);
   
 private:
   float               transitionClock;
@@ -0,0 +1,218 @@
+#include "ofxTask.h"
+#include "ofxMessageTimeline.h"
+#include "ofxStateMachine.h"
+#include "ofxClock.h"
+#include <algorithm>
+
+vector<ofxTask *> ofxTask::readyTasks;
+vector<ofxTask *> ofxTask::resumingTasks;
+multimap<ofxMessage *, ofxTask *> ofxTask::messageWaiters;
+multimap<ofxStateMachine *, pair<string, ofxTask *> > ofxTask::stateWaiters;
+
+ofxTask::ofxTask()
+{
+	autoDelete = true;
+	timeline = NULL;
+	nextStep = 0;
+	running = false;
+	waiting = false;
+	looping = false;
+	timer = NULL;
+	waitMessage = NULL;
+	waitMachine = NULL;
+}
+
+ofxTask::~ofxTask()
+{
+	cancelWait();
+
+	readyTasks.erase(std::remove(readyTasks.begin(), readyTasks.end(), this), readyTasks.end());
+	//may be deleted by another task's step while the ready tasks are resumed
+	replace(resumingTasks.begin(), resumingTasks.end(), this, (ofxTask *)NULL);
+}
+
+ofxTask* ofxTask::then(const ofxTaskStep &iStep)
+{
+	steps.push_back(iStep);
+	return this;
+}
+
+ofxTask* ofxTask::thenWait(float iSeconds)
+{
+	return then([iSeconds](ofxTask &iTask){ iTask.sleep(iSeconds); });
+}
+
+//Looping tasks start over from their first step after the last one.
+void ofxTask::setLooping(bool iLoop)
+{
+	looping = iLoop;
+}
+
+//Stops waiting and won't run any more steps. Doesn't delete the task.
+void ofxTask::stop()
+{
+	cancelWait();
+	readyTasks.erase(std::remove(readyTasks.begin(), readyTasks.end(), this), readyTasks.end());
+	running = false;
+}
+
+void ofxTask::sleep(float iSeconds)
+{
+	if(!timeline) return;
+	cancelWait();
+
+	timer = new ofxMessage(OF_FUNCTION, &ofxTask::wakeFromTimer, this, iSeconds);
+	timer->autoDelete = false;
+	timer->setStartTime(ofxClock::getCurrentTime());
+	timeline->add(NULL, timer);
+	waiting = true;
+}
+
+//Waits until iMessage completes or is deleted.
+void ofxTask::waitFor(ofxMessage *iMessage)
+{
+	cancelWait();
+	waiting = true;
+
+	//already done
+	if(!iMessage->isEnabled && !iMessage->timeline){
+		wake();
+		return;
+	}
+	waitMessage = iMessage;
+	messageWaiters.insert(make_pair(iMessage, this));
+}
+
+//Waits until iMachine is in iState, which may be right away.
+void ofxTask::waitFor(ofxStateMachine *iMachine, string iState)
+{
+	cancelWait();
+	waiting = true;
+
+	if(iMachine->getCurState() == iState){
+		wake();
+		return;
+	}
+	waitMachine = iMachine;
+	stateWaiters.insert(make_pair(iMachine, make_pair(iState, this)));
+}
+
+//Runs the steps of every task woken since the last call. Called by ofxMessageTimeline::update().
+void ofxTask::resumeReady()
+{
+	if(readyTasks.empty() || !resumingTasks.empty()) return;
+
+	resumingTasks.swap(readyTasks);
+	for(unsigned int i = 0; i < resumingTasks.size(); i++){
+		if(resumingTasks[i]) resumingTasks[i]->resume();
+	}
+	resumingTasks.clear();
+}
+
+void ofxTask::messageFinished(ofxMessage *iMessage)
+{
+	if(messageWaiters.empty()) return;
+
+	pair<multimap<ofxMessage *, ofxTask *>::iterator, multimap<ofxMessage *, ofxTask *>::iterator> range = messageWaiters.equal_range(iMessage);
+	vector<ofxTask *> woken;
+	for(multimap<ofxMessage *, ofxTask *>::iterator it = range.first; it != range.second; ++it)
+		woken.push_back(it->second);
+	messageWaiters.erase(range.first, range.second);
+
+	for(unsigned int i = 0; i < woken.size(); i++){
+		woken[i]->waitMessage = NULL;
+		woken[i]->wake();
+	}
+}
+
+void ofxTask::stateEntered(ofxStateMachine *iMachine, ofxState *iState)
+{
+	if(stateWaiters.empty() || !iState) return;
+
+	typedef multimap<ofxStateMachine *, pair<string, ofxTask *> >::iterator Iterator;
+	pair<Iterator, Iterator> range = stateWaiters.equal_range(iMachine);
+	vector<ofxTask *> woken;
+	for(Iterator it = range.first; it != range.second;){
+		if(it->second.first == iState->name){
+			woken.push_back(it->second.second);
+			stateWaiters.erase(it++);
+		}else
+			++it;
+	}
+
+	for(unsigned int i = 0; i < woken.size(); i++){
+		woken[i]->waitMachine = NULL;
+		woken[i]->wake();
+	}
+}
+
+//Queues the task to run its next steps at the end of the update.
+void ofxTask::wake()
+{
+	if(find(readyTasks.begin(), readyTasks.end(), this) == readyTasks.end())
+		readyTasks.push_back(this);
+}
+
+void ofxTask::resume()
+{
+	if(timer){
+		delete timer;
+		timer = NULL;
+	}
+	waiting = false;
+	running = true;
+
+	while(!waiting){
+		if(nextStep >= (int)steps.size()){
+			if(!looping || steps.empty()) break;
+
+			//a pass without waits picks up again next update, rather than spinning here
+			nextStep = 0;
+			wake();
+			return;
+		}
+		steps[nextStep++](*this);
+		//the step may have stopped the task
+		if(!running) return;
+	}
+	if(waiting) return;
+
+	running = false;
+	if(autoDelete) delete this;
+}
+
+void ofxTask::cancelWait()
+{
+	if(timer){
+		delete timer;
+		timer = NULL;
+	}
+	if(waitMessage){
+		pair<multimap<ofxMessage *, ofxTask *>::iterator, multimap<ofxMessage *, ofxTask *>::iterator> range = messageWaiters.equal_range(waitMessage);
+		for(multimap<ofxMessage *, ofxTask *>::iterator it = range.first; it != range.second; ++it){
+			if(it->second == this){
+				messageWaiters.erase(it);
+				break;
+			}
+		}
+		waitMessage = NULL;
+	}
+	if(waitMachine){
+		typedef multimap<ofxStateMachine *, pair<string, ofxTask *> >::iterator Iterator;
+		pair<Iterator, Iterator> range = stateWaiters.equal_range(waitMachine);
+		for(Iterator it = range.first; it != range.second; ++it){
+			if(it->second.second == this){
+				stateWaiters.erase(it);
+				break;
+			}
+		}
+		waitMachine = NULL;
+	}
+	waiting = false;
+}
+
+float ofxTask::wakeFromTimer(void *iTask)
+{
+	((ofxTask *)iTask)->wake();
+	return 0;
+}
@@ -0,0 +1,99 @@
+/*
+ofxTask
+
+Scripts a sequence of steps that wait on time, messages or state machines in between, like:
+
+	ofxTask *task = new ofxTask();
+	task->then([=](ofxTask &t){ t.waitFor(obj->doMessage3f(OF_TRANSLATE, 0, 1, OF_EASE_OUT, 100, 0, 0)); })
+		->thenWait(0.5)
+		->then([=](ofxTask &t){ machine->gotoState("open"); t.waitFor(machine, "open"); })
+		->then([=](ofxTask &t){ obj->hide(); });
+	scene->getTimeline()->addTask(task);
+
+Steps run one after another until one of them calls sleep() or waitFor(). The task is then parked until that
+happens, with no per-frame checks: sleeps are timer messages on the timeline's heap, and messages and state
+machines wake their waiting tasks when they finish or change state. Waiting on a message lasts until it
+completes or is deleted, so don't wait on a looping one.
+Woken tasks resume at the end of the timeline's update, after its events. Tasks delete themselves when their
+last step is done, unless autoDelete is off or they loop.
+
+Soso OpenFrameworks Addon
+Copyright (C) 2012 Sosolimited
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+and associated documentation files (the "Software"), to deal in the Software without restriction, 
+including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense, 
+and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, 
+subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL 
+THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF 
+CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "ofxMessage.h"
+#include <functional>
+#include <map>
+#include <string>
+
+class ofxStateMachine;
+class ofxState;
+class ofxTask;
+
+typedef std::function<void(ofxTask &)> ofxTaskStep;
+
+class ofxTask
+{
+public:
+	ofxTask();
+	~ofxTask();
+
+	ofxTask*						then(const ofxTaskStep &iStep);
+	ofxTask*						thenWait(float iSeconds);
+	void							setLooping(bool iLoop);
+	void							stop();
+	bool							isRunning(){ return running; }
+	bool							isWaiting(){ return waiting; }
+
+	//call these from a step, to wait before the next one
+	void							sleep(float iSeconds);
+	void							waitFor(ofxMessage *iMessage);
+	void							waitFor(ofxStateMachine *iMachine, string iState);
+
+	static void						resumeReady();
+	static void						messageFinished(ofxMessage *iMessage);
+	static void						stateEntered(ofxStateMachine *iMachine, ofxState *iState);
+
+protected:
+	void							wake();
+	void							resume();
+	void							cancelWait();
+	static float					wakeFromTimer(void *iTask);
+
+public:
+	bool							autoDelete;
+	ofxMessageTimeline				*timeline;		//set by ofxMessageTimeline::addTask()
+
+protected:
+	vector<ofxTaskStep>				steps;
+	int								nextStep;
+	bool							running;
+	bool							waiting;
+	bool							looping;
+	ofxMessage						*timer;
+	ofxMessage						*waitMessage;
+	ofxStateMachine					*waitMachine;
+
+	static vector<ofxTask *>		readyTasks;
+	static vector<ofxTask *>		resumingTasks;
+	static multimap<ofxMessage *, ofxTask *>		messageWaiters;
+	static multimap<ofxStateMachine *, pair<string, ofxTask *> >	stateWaiters;
+
+	friend class ofxMessageTimeline;
+};
@@ -0,0 +1,101 @@
+#include "ofxVertexBuffer.h"
+
+ofxVertexBuffer::ofxVertexBuffer()
+{
+  vbo = 0;
+  setNumVertices(0);
+}
+
+ofxVertexBuffer::~ofxVertexBuffer()
+{
+  if(vbo) glDeleteBuffers(1, &vbo);
+}
+
+void ofxVertexBuffer::setNumVertices(int iNumVertices)
+{
+  if(vbo && (iNumVertices != numVertices)){
+    glDeleteBuffers(1, &vbo);
+    vbo = 0;
+  }
+  
+  numVertices = iNumVertices;
+  posDirtyFrom = texDirtyFrom = colorDirtyFrom = 0;
+  posDirtyTo = texDirtyTo = colorDirtyTo = numVertices-1;
+}
+
+//Sends the dirty ranges of the given arrays, which must hold numVertices vertices each.
+void ofxVertexBuffer::upload(const float *iVertices, const float *iTexCoords, const float *iColors)
+{
+  if(numVertices < 1) return;
+  
+  if(!vbo){
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, 9*numVertices*sizeof(float), NULL, GL_DYNAMIC_DRAW);
+    markPositionsDirty(0, numVertices-1);
+    markTexCoordsDirty(0, numVertices-1);
+    markColorsDirty(0, numVertices-1);
+  }
+  else if((posDirtyTo < posDirtyFrom) && (texDirtyTo < texDirtyFrom) && (colorDirtyTo < colorDirtyFrom))
+    return;
+  else
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+  
+  if(posDirtyTo >= posDirtyFrom){
+    glBufferSubData(GL_ARRAY_BUFFER, 3*posDirtyFrom*sizeof(float), 3*(posDirtyTo - posDirtyFrom + 1)*sizeof(float), &iVertices[3*posDirtyFrom]);
+    posDirtyFrom = numVertices;
+    posDirtyTo = -1;
+  }
+  
+  if(texDirtyTo >= texDirtyFrom){
+    glBufferSubData(GL_ARRAY_BUFFER, (3*numVertices + 2*texDirtyFrom)*sizeof(float), 2*(texDirtyTo - texDirtyFrom + 1)*sizeof(float), &iTexCoords[2*texDirtyFrom]);
+    texDirtyFrom = numVertices;
+    texDirtyTo = -1;
+  }
+  
+  if(colorDirtyTo >= colorDirtyFrom){
+    glBufferSubData(GL_ARRAY_BUFFER, (5*numVertices + 4*colorDirtyFrom)*sizeof(float), 4*(colorDirtyTo - colorDirtyFrom + 1)*sizeof(float), &iColors[4*colorDirtyFrom]);
+    colorDirtyFrom = numVertices;
+    colorDirtyTo = -1;
+  }
+  
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void ofxVertexBuffer::markPositionsDirty(int iFrom, int iTo)
+{
+  posDirtyFrom = MIN(posDirtyFrom, iFrom);
+  posDirtyTo = MAX(posDirtyTo, iTo);
+}
+
+void ofxVertexBuffer::markTexCoordsDirty(int iFrom, int iTo)
+{
+  texDirtyFrom = MIN(texDirtyFrom, iFrom);
+  texDirtyTo = MAX(texDirtyTo, iTo);
+}
+
+void ofxVertexBuffer::markColorsDirty(int iFrom, int iTo)
+{
+  colorDirtyFrom = MIN(colorDirtyFrom, iFrom);
+  colorDirtyTo = MAX(colorDirtyTo, iTo);
+}
+
+void ofxVertexBuffer::bind()
+{
+  glBindBuffer(GL_ARRAY_BUFFER, vbo);
+}
+
+void ofxVertexBuffer::unbind()
+{
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+GLvoid* ofxVertexBuffer::getTexCoordsOffset()
+{
+  return (GLvoid *)(3*numVertices*sizeof(float));
+}
+
+GLvoid* ofxVertexBuffer::getColorsOffset()
+{
+  return (GLvoid *)(5*numVertices*sizeof(float));
+}
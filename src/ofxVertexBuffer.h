@@ -0,0 +1,62 @@
+/*
+ ofxVertexBuffer
+ 
+ Vertex buffer shared by ofxPolygonObject and ofxQuadStripObject. Holds all positions (3 floats per vertex),
+ then all tex coords (2 floats), then all colors (4 floats), and tracks the range of each that changed since
+ the last upload, so only those vertices are sent again. The vertex data itself stays with the owning object.
+ 
+ Soso OpenFrameworks Addon
+ Copyright (C) 2012 Sosolimited
+ 
+ Permission is hereby granted, free of charge, to any person obtaining a copy of this software
+ and associated documentation files (the "Software"), to deal in the Software without restriction,
+ including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ subject to the following conditions:
+ 
+ The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ 
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED
+ TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF
+ CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ IN THE SOFTWARE.
+ */
+
+#pragma once
+
+#include "ofConstants.h"
+
+class ofxVertexBuffer
+{
+public:
+  ofxVertexBuffer();
+  ~ofxVertexBuffer();
+  
+  void                  setNumVertices(int iNumVertices);   //marks everything dirty
+  
+  void                  markPositionsDirty(int iFrom, int iTo);
+  void                  markTexCoordsDirty(int iFrom, int iTo);
+  void                  markColorsDirty(int iFrom, int iTo);
+  void                  upload(const float *iVertices, const float *iTexCoords, const float *iColors);
+  
+  // binds the buffer for glVertexPointer(3, GL_FLOAT, 0, 0) and the offsets below
+  void                  bind();
+  void                  unbind();
+  GLvoid*               getTexCoordsOffset();
+  GLvoid*               getColorsOffset();
+  
+protected:
+  GLuint                vbo;
+  int                   numVertices;
+  int                   posDirtyFrom,     //range of vertices changed since the last upload
+                        posDirtyTo,
+                        texDirtyFrom,
+                        texDirtyTo,
+                        colorDirtyFrom,
+                        colorDirtyTo;
+  
+private:
+  ofxVertexBuffer(const ofxVertexBuffer &);
+  ofxVertexBuffer&      operator=(const ofxVertexBuffer &);
+};